@@ -4,155 +4,193 @@
 #include <iostream>
 #include <string>
 #include <algorithm>
-#include <cstdlib>
-#include <ctime>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
 #include <vector>
 
+// Bit string packed into 64-bit words. Bit 0 is the leftmost (most significant)
+// digit and sits in the highest bit of words[0], so any run of up to 64 digits
+// is read or written with at most two word operations. Bits past numDigits()
+// are always zero.
 class BinaryNumber {
 private:
-    std::string binary; // To store binary number as a string
+    std::vector<uint64_t> words;
+    size_t nbits = 0;
 
-public:
-    // Default constructor
-    static inline int call_counter=0;
-    BinaryNumber(const std::string &bin = "") : binary(bin) {}
+    static uint64_t lowMask(unsigned int n) {
+        return n >= 64 ? ~uint64_t(0) : ((uint64_t(1) << n) - 1);
+    }
 
-    // Copy constructor
-    BinaryNumber(const BinaryNumber &other) {
-        binary = other.binary;
-        //std::cout << "Copy constructor called\n";
+    // Digits [pos, pos + n) as an unsigned number, n <= 64
+    uint64_t getBits(size_t pos, unsigned int n) const {
+        if (n == 0) return 0;
+        const size_t w = pos >> 6;
+        const unsigned int off = pos & 63;
+        uint64_t window = words[w] << off;
+        if (off > 0 && w + 1 < words.size())
+            window |= words[w + 1] >> (64 - off);
+        return window >> (64 - n);
     }
 
-    // Assignment operator
-    BinaryNumber &operator=(const BinaryNumber &other) {
-        if (this != &other) { // Prevent self-assignment
-            binary = other.binary;
+    // Append the n low bits of value, most significant first, n <= 64
+    void appendBits(uint64_t value, unsigned int n) {
+        if (n == 0) return;
+        const uint64_t aligned = (value & lowMask(n)) << (64 - n);
+        const unsigned int off = nbits & 63;
+        if (off == 0)
+            words.push_back(aligned);
+        else {
+            words.back() |= aligned >> off;
+            if (off + n > 64)
+                words.push_back(aligned << (64 - off));
         }
-        return *this;
+        nbits += n;
     }
 
-    // Function to convert a decimal number to binary
-    static BinaryNumber decimalToBinary(int decimal) {
-        std::string result;
-        while (decimal > 0) {
-            result += (decimal % 2 == 0 ? "0" : "1");
-            decimal /= 2;
+    // Append digits [pos, pos + n) of other, a word at a time
+    void appendRange(const BinaryNumber &other, size_t pos, size_t n) {
+        while (n >= 64) {
+            appendBits(other.getBits(pos, 64), 64);
+            pos += 64;
+            n -= 64;
         }
-        std::reverse(result.begin(), result.end());
-        return result.empty() ? "0" : result;
+        appendBits(other.getBits(pos, static_cast<unsigned int>(n)), static_cast<unsigned int>(n));
+    }
+
+public:
+    BinaryNumber() = default;
+    BinaryNumber(const std::string &bin) { setBinary(bin); }
+
+    // Number of 'value' with exactly 'digits' digits
+    static BinaryNumber fromDecimal(uint64_t value, unsigned int digits) {
+        BinaryNumber result;
+        result.words.reserve((digits + 63) / 64);
+        unsigned int d = digits;
+        for (; d > 64; d -= 64)
+            result.appendBits(0, 64);
+        result.appendBits(value, d);
+        return result;
+    }
+
+    // Function to convert a decimal number to binary (no leading zeros)
+    static BinaryNumber decimalToBinary(unsigned long decimal) {
+        return fromDecimal(decimal, digitsForMaxDecimal(decimal));
     }
 
     // Function to convert binary to decimal
-    static int binaryToDecimal(const std::string &bin) {
-        int decimal = 0;
+    static unsigned long binaryToDecimal(const std::string &bin) {
+        unsigned long decimal = 0;
         for (char digit : bin) {
             decimal = (decimal << 1) + (digit - '0');
         }
         return decimal;
     }
 
-    // Function to set binary value
+    // Function to set binary value from a string of '0'/'1'
     void setBinary(const std::string &bin) {
-        binary = bin;
+        words.clear();
+        nbits = 0;
+        for (size_t pos = 0; pos < bin.size(); pos += 64) {
+            const size_t n = std::min<size_t>(64, bin.size() - pos);
+            appendBits(binaryToDecimal(bin.substr(pos, n)), static_cast<unsigned int>(n));
+        }
     }
 
-    // Function to get binary value
+    // Function to get binary value as a string of '0'/'1'
     std::string getBinary() const {
-        return binary;
+        std::string result(nbits, '0');
+        for (size_t i = 0; i < nbits; ++i)
+            if ((words[i >> 6] >> (63 - (i & 63))) & 1)
+                result[i] = '1';
+        return result;
     }
 
-    // Function to display decimal equivalent of the stored binary
-    int toDecimal() const {
-        return binaryToDecimal(binary);
+    // Decimal value of the stored digits (the last 64 if there are more)
+    unsigned long toDecimal() const {
+        return nbits <= 64 ? getBits(0, static_cast<unsigned int>(nbits)) : getBits(nbits - 64, 64);
     }
 
-    // Function to perform crossover between two BinaryNumbers at a random point
-    static BinaryNumber crossover(const BinaryNumber &bn1, const BinaryNumber &bn2) {
-        // Initialize random seed
-        std::srand(static_cast<unsigned>(std::time(nullptr)+call_counter));
-        call_counter++;
-        // Determine the minimum length of the two binary strings
-        size_t minLength = std::min(bn1.binary.size(), bn2.binary.size());
+    // Prefix of bn1 up to a random point followed by the rest of bn2
+    static BinaryNumber crossover(const BinaryNumber &bn1, const BinaryNumber &bn2, std::mt19937_64 &rng) {
+        const size_t minLength = std::min(bn1.nbits, bn2.nbits);
+        if (minLength == 0)
+            throw std::logic_error("Binary string is empty. Cannot perform crossover.");
 
-        // Generate a random crossover point
-        size_t crossoverPoint = std::rand() % minLength;
+        const size_t crossoverPoint = std::uniform_int_distribution<size_t>(0, minLength - 1)(rng);
 
-        std::cout << "Random Crossover Point: " << crossoverPoint << std::endl;
-
-        // Perform the crossover
-        std::string newBinary = bn1.binary.substr(0, crossoverPoint) + bn2.binary.substr(crossoverPoint);
-        return BinaryNumber(newBinary);
+        BinaryNumber result;
+        result.words.reserve(bn2.words.size());
+        result.appendRange(bn1, 0, crossoverPoint);
+        result.appendRange(bn2, crossoverPoint, bn2.nbits - crossoverPoint);
+        return result;
     }
 
     // Display the binary number
     void display() const {
-        std::cout << "Binary: " << binary << std::endl;
+        std::cout << "Binary: " << getBinary() << std::endl;
     }
 
     BinaryNumber operator+(const BinaryNumber &other) const {
-            return BinaryNumber(binary + other.binary);
+        BinaryNumber result(*this);
+        result += other;
+        return result;
     }
 
     BinaryNumber &operator+=(const BinaryNumber &other) {
-        if (this->binary.empty())
-            this->binary = other.binary;
-        else
-            this->binary += other.binary; // Append the binary string of `other` to this object
-        return *this; // Return the current object for chaining
+        words.reserve((nbits + other.nbits + 63) / 64);
+        appendRange(other, 0, other.nbits);
+        return *this;
     }
 
-    static BinaryNumber randomBinary(int maxDecimal) {
-        call_counter++;
-        if (maxDecimal < 0) {
-            throw std::invalid_argument("Maximum decimal value must be non-negative.");
-        }
-
-        // Seed the random number generator
-        std::srand(static_cast<unsigned>(std::time(nullptr)+call_counter));
-
-        // Generate a random decimal number in the range [0, maxDecimal]
-        int randomDecimal = std::rand() % (maxDecimal + 1);
-
-        // Convert the random decimal to binary
-        BinaryNumber binaryString = decimalToBinary(randomDecimal);
+    // Drop all digits, keeping the storage
+    void clear() {
+        words.clear();
+        nbits = 0;
+    }
 
-        // Return the resulting BinaryNumber
-        return binaryString;
+    // Uniform number in [0, maxDecimal], without leading zeros
+    static BinaryNumber randomBinary(unsigned long maxDecimal, std::mt19937_64 &rng) {
+        std::uniform_int_distribution<unsigned long> distribution(0, maxDecimal);
+        return decimalToBinary(distribution(rng));
     }
+
     std::vector<BinaryNumber> split(const std::vector<unsigned int> &segmentLengths) const {
         std::vector<BinaryNumber> segments;
-        size_t currentIndex = 0;
-
-        for (unsigned int length : segmentLengths) {
-            if (currentIndex + length > binary.size()) {
-                throw std::out_of_range("Segment length exceeds binary string length.");
-            }
+        split(segmentLengths, segments);
+        return segments;
+    }
 
-            // Extract the segment
-            std::string segment = binary.substr(currentIndex, length);
-            segments.emplace_back(segment);
+    // Split into consecutive segments, reusing the storage already in 'segments'
+    void split(const std::vector<unsigned int> &segmentLengths, std::vector<BinaryNumber> &segments) const {
+        size_t total = 0;
+        for (unsigned int length : segmentLengths)
+            total += length;
 
-            // Move to the next segment
-            currentIndex += length;
+        if (total > nbits) {
+            throw std::out_of_range("Segment length exceeds binary string length.");
         }
-
-        if (currentIndex < binary.size()) {
+        if (total < nbits) {
             throw std::invalid_argument("Unused portion of the binary string remains after splitting.");
         }
 
-        return segments;
+        segments.resize(segmentLengths.size());
+        size_t currentIndex = 0;
+        for (size_t s = 0; s < segmentLengths.size(); ++s) {
+            segments[s].clear();
+            segments[s].appendRange(*this, currentIndex, segmentLengths[s]);
+            currentIndex += segmentLengths[s];
+        }
     }
-    static int maxDecimalForBinarySize(unsigned int size) {
+
+    static unsigned long maxDecimalForBinarySize(unsigned int size) {
         if (size == 0) {
             throw std::invalid_argument("Binary size must be greater than 0.");
         }
-        return (1 << size) - 1; // 2^size - 1
+        return lowMask(size); // 2^size - 1
     }
 
-    static unsigned int digitsForMaxDecimal(int maxDecimal) {
-        if (maxDecimal < 0) {
-            throw std::invalid_argument("Maximum decimal number must be non-negative.");
-        }
+    static unsigned int digitsForMaxDecimal(unsigned long maxDecimal) {
         unsigned int digits = 0;
         while (maxDecimal > 0) {
             maxDecimal >>= 1; // Equivalent to dividing by 2
@@ -160,57 +198,63 @@ public:
         }
         return digits == 0 ? 1 : digits; // Ensure at least one digit for 0
     }
+
+    // Add leading zeros up to maxDigits
     void fixSize(unsigned int maxDigits) {
-        if (binary.size() > maxDigits) {
+        if (nbits > maxDigits) {
             throw std::invalid_argument("Binary string exceeds the maximum specified digits.");
         }
+        if (nbits == maxDigits)
+            return;
 
-        // Add leading zeros if the current size is less than maxDigits
-        while (binary.size() < maxDigits) {
-            binary = '0' + binary;
-        }
+        BinaryNumber padded = fromDecimal(0, static_cast<unsigned int>(maxDigits - nbits));
+        padded += *this;
+        *this = std::move(padded);
     }
+
     unsigned int numDigits() const {
-        return binary.size();
+        return static_cast<unsigned int>(nbits);
     }
-    void mutate(unsigned int numMutations = 1) {
-        if (binary.empty()) {
+
+    // Flip numMutations randomly chosen digits
+    void mutate(unsigned int numMutations, std::mt19937_64 &rng) {
+        if (nbits == 0) {
             throw std::logic_error("Binary string is empty. Cannot perform mutation.");
         }
 
-        // Seed the random number generator
-        std::srand(static_cast<unsigned>(std::time(nullptr)));
-
-        // Perform the specified number of mutations
+        std::uniform_int_distribution<size_t> position(0, nbits - 1);
         for (unsigned int i = 0; i < numMutations; ++i) {
-            // Randomly select a position in the binary string
-            size_t position = std::rand() % binary.size();
-
-            // Flip the bit at the selected position
-            binary[position] = (binary[position] == '0') ? '1' : '0';
+            const size_t p = position(rng);
+            words[p >> 6] ^= uint64_t(1) << (63 - (p & 63));
         }
     }
-    void mutate(const double &mutationProbability) {
+
+    // Flip every digit independently with mutationProbability. The gaps between
+    // flipped digits are geometric, so only the flipped digits cost a draw.
+    void mutate(double mutationProbability, std::mt19937_64 &rng) {
         if (mutationProbability < 0.0 || mutationProbability > 1.0) {
             throw std::invalid_argument("Mutation probability must be between 0 and 1.");
         }
 
-        if (binary.empty()) {
+        if (nbits == 0) {
             throw std::logic_error("Binary string is empty. Cannot perform mutation.");
         }
 
-        // Seed the random number generator
-        std::srand(static_cast<unsigned>(std::time(nullptr)+call_counter));
-        call_counter++;
-        // Iterate through each digit in the binary string
-        for (size_t i = 0; i < binary.size(); ++i) {
-            double randomValue = static_cast<double>(std::rand()) / RAND_MAX; // Generate a random value between 0 and 1
-
-            // Flip the bit with the given mutation probability
-            if (randomValue < mutationProbability) {
-                binary[i] = (binary[i] == '0') ? '1' : '0';
-            }
+        if (mutationProbability == 0.0)
+            return;
+
+        // geometric_distribution needs p < 1: flip every digit, keeping the bits past nbits zero
+        if (mutationProbability == 1.0) {
+            for (uint64_t &word : words)
+                word = ~word;
+            if (nbits & 63)
+                words.back() &= ~lowMask(64 - (nbits & 63));
+            return;
         }
+
+        std::geometric_distribution<size_t> gap(mutationProbability);
+        for (size_t p = gap(rng); p < nbits; p += 1 + gap(rng))
+            words[p >> 6] ^= uint64_t(1) << (63 - (p & 63));
     }
 };
 
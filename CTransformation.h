@@ -4,6 +4,10 @@
  *
  * Each row represents a feature and each column a sample.
  * Normalization: (x - min) / (max - min)
+ *
+ * The kernels sweep the matrix column by column (the Armadillo storage
+ * order) with OpenMP threads over columns and SIMD over rows; normalize()
+ * reads the data once for min/max and once for the scaling.
  */
 
 #ifndef CTRANSFORMATION_H
@@ -16,71 +20,182 @@
 #include <vector>
 #include <stdexcept>
 #include <iomanip> // for formatting
+#include <algorithm>
+#include <string>
 
 class CTransformation {
 private:
     arma::colvec minValues;  // Minimum values per feature
     arma::colvec maxValues;  // Maximum values per feature
 
-public:
+    // Matrices smaller than this are swept by one thread
+    static constexpr arma::uword ParallelThreshold = 1 << 16;
+
     // ───────────────────────────────────────────────
-    // Normalize each row to [0, 1]
+    // Column-sweep kernels
+    //
+    // Armadillo stores matrices column by column, so row(i) touches one
+    // element per column. These kernels walk the memory in order instead:
+    // columns are split between threads and the rows of a column (one
+    // contiguous block) form the SIMD loop.
     // ───────────────────────────────────────────────
-    arma::mat normalize(const arma::mat& data)
-    {
-        if (data.has_nan())
-            std::cerr << "⚠️ [Normalize] Data contains NaN values!" << std::endl;
 
-        if (data.has_inf())
-            std::cerr << "⚠️ [Normalize] Data contains Inf values!" << std::endl;
+    // Per-row min/max in one pass over the data
+    static void RowMinMax(const arma::mat& data, arma::colvec& minVals, arma::colvec& maxVals)
+    {
+        const arma::uword n_rows = data.n_rows, n_cols = data.n_cols;
+        minVals.set_size(n_rows);
+        maxVals.set_size(n_rows);
+        minVals.fill(arma::Datum<double>::inf);
+        maxVals.fill(-arma::Datum<double>::inf);
+        double* globalMin = minVals.memptr();
+        double* globalMax = maxVals.memptr();
+
+        #pragma omp parallel if(data.n_elem >= ParallelThreshold)
+        {
+            std::vector<double> localMin(n_rows, arma::Datum<double>::inf);
+            std::vector<double> localMax(n_rows, -arma::Datum<double>::inf);
+            double* lo = localMin.data();
+            double* hi = localMax.data();
 
-        std::cout << "\n[Normalize] Starting normalization..." << std::endl;
-        std::cout << "  Input size: " << data.n_rows << " × " << data.n_cols << std::endl;
+            #pragma omp for schedule(static) nowait
+            for (arma::sword c = 0; c < static_cast<arma::sword>(n_cols); ++c)
+            {
+                const double* column = data.colptr(c);
+                #pragma omp simd
+                for (arma::uword r = 0; r < n_rows; ++r)
+                {
+                    lo[r] = column[r] < lo[r] ? column[r] : lo[r];
+                    hi[r] = column[r] > hi[r] ? column[r] : hi[r];
+                }
+            }
 
-        if (data.is_empty())
-        {
-            std::cerr << "❌ [Normalize] Input data is empty!" << std::endl;
-            return data;
+            #pragma omp critical(ctransformation_minmax)
+            for (arma::uword r = 0; r < n_rows; ++r)
+            {
+                globalMin[r] = std::min(globalMin[r], lo[r]);
+                globalMax[r] = std::max(globalMax[r], hi[r]);
+            }
         }
+    }
 
-        minValues = arma::min(data, 1);
-        maxValues = arma::max(data, 1);
+    // out(r, c) = (in(r, c) - offset(r)) * scale(r)  when Forward,
+    // out(r, c) =  in(r, c) * scale(r) + offset(r)   otherwise
+    template<bool Forward>
+    static arma::mat Scale(const arma::mat& in, const arma::colvec& offset, const arma::colvec& scale)
+    {
+        const arma::uword n_rows = in.n_rows, n_cols = in.n_cols;
+        arma::mat out(n_rows, n_cols, arma::fill::none);
+        const double* o = offset.memptr();
+        const double* s = scale.memptr();
 
-        arma::mat normalizedData = data;
+        #pragma omp parallel for schedule(static) if(in.n_elem >= ParallelThreshold)
+        for (arma::sword c = 0; c < static_cast<arma::sword>(n_cols); ++c)
+        {
+            const double* src = in.colptr(c);
+            double* dst = out.colptr(c);
+            #pragma omp simd
+            for (arma::uword r = 0; r < n_rows; ++r)
+                dst[r] = Forward ? (src[r] - o[r]) * s[r] : src[r] * s[r] + o[r];
+        }
+        return out;
+    }
 
-        for (arma::uword i = 0; i < data.n_rows; ++i)
+    // Reciprocal ranges for the forward scaling; rows with an invalid or
+    // zero range get scale 0
+    arma::colvec ForwardScale(const char* tag, bool resetInvalid)
+    {
+        arma::colvec scale(minValues.n_elem);
+        for (arma::uword i = 0; i < minValues.n_elem; ++i)
         {
-            double minVal = minValues(i);
-            double maxVal = maxValues(i);
-            double range = maxVal - minVal;
+            const double minVal = minValues(i);
+            const double maxVal = maxValues(i);
+            const double range = maxVal - minVal;
 
             if (!arma::is_finite(minVal) || !arma::is_finite(maxVal) || range <= 1e-12)
             {
-                std::cerr << "⚠️ [Normalize] Invalid or zero range at row " << i
-                          << " (min=" << minVal << ", max=" << maxVal
-                          << "). Setting normalized row to zeros." << std::endl;
-                minValues(i) = 0.0;
-                maxValues(i) = 1.0;
-                normalizedData.row(i).zeros();
+                // Fitted ranges are always reported; stored zero ranges (constant
+                // inputs of a fitted or loaded model) only when verbose
+                if (resetInvalid || verbose)
+                    std::cerr << "⚠️ [" << tag << "] Invalid or zero range at row " << i
+                              << " (min=" << minVal << ", max=" << maxVal
+                              << "). Setting normalized row to zeros." << std::endl;
+                if (resetInvalid)
+                {
+                    minValues(i) = 0.0;
+                    maxValues(i) = 1.0;
+                }
+                scale(i) = 0.0;
                 continue;
             }
+            scale(i) = 1.0 / range;
+        }
+        return scale;
+    }
+
+    // Rows flagged by ForwardScale() become exact zeros (also where the data is Inf/NaN)
+    static void ZeroInvalidRows(arma::mat& data, const arma::colvec& scale)
+    {
+        for (arma::uword i = 0; i < scale.n_elem; ++i)
+            if (scale(i) == 0.0)
+                data.row(i).zeros();
+    }
+
+    void CheckRows(const arma::mat& data, const char* tag) const
+    {
+        if (data.n_rows != minValues.n_elem)
+            throw std::invalid_argument(std::string("❌ [") + tag + "] Data has " + std::to_string(data.n_rows)
+                                        + " rows but " + std::to_string(minValues.n_elem) + " parameters are loaded!");
+    }
+
+public:
+    bool verbose = true;     // progress and min/max printing on stdout (warnings always go to stderr)
 
-            normalizedData.row(i) = (data.row(i) - minVal) / range;
+    // ───────────────────────────────────────────────
+    // Normalize each row to [0, 1]
+    // ───────────────────────────────────────────────
+    arma::mat normalize(const arma::mat& data)
+    {
+        if (data.has_nan())
+            std::cerr << "⚠️ [Normalize] Data contains NaN values!" << std::endl;
+
+        if (verbose)
+        {
+            std::cout << "\n[Normalize] Starting normalization..." << std::endl;
+            std::cout << "  Input size: " << data.n_rows << " × " << data.n_cols << std::endl;
         }
 
-        // Debug: print all min and max values
-        std::cout << std::fixed << std::setprecision(6);
-        std::cout << "[Normalize] Completed." << std::endl;
+        if (data.is_empty())
+        {
+            std::cerr << "❌ [Normalize] Input data is empty!" << std::endl;
+            return data;
+        }
 
-        std::cout << "  All min values:" << std::endl;
-        for (arma::uword i = 0; i < minValues.n_elem; ++i)
-            std::cout << "    " << minValues(i);
-        std::cout << std::endl;
+        RowMinMax(data, minValues, maxValues);
+
+        if (!minValues.is_finite() || !maxValues.is_finite())
+            std::cerr << "⚠️ [Normalize] Data contains Inf values!" << std::endl;
+
+        const arma::colvec scale = ForwardScale("Normalize", true);
+        arma::mat normalizedData = Scale<true>(data, minValues, scale);
+        ZeroInvalidRows(normalizedData, scale);
 
-        std::cout << "  All max values:" << std::endl;
-        for (arma::uword i = 0; i < maxValues.n_elem; ++i)
-            std::cout << "    " << maxValues(i);
-        std::cout << std::endl;
+        if (verbose)
+        {
+            // Debug: print all min and max values
+            std::cout << std::fixed << std::setprecision(6);
+            std::cout << "[Normalize] Completed." << std::endl;
+
+            std::cout << "  All min values:" << std::endl;
+            for (arma::uword i = 0; i < minValues.n_elem; ++i)
+                std::cout << "    " << minValues(i);
+            std::cout << std::endl;
+
+            std::cout << "  All max values:" << std::endl;
+            for (arma::uword i = 0; i < maxValues.n_elem; ++i)
+                std::cout << "    " << maxValues(i);
+            std::cout << std::endl;
+        }
 
         return normalizedData;
     }
@@ -90,34 +205,22 @@ public:
     // ───────────────────────────────────────────────
     arma::mat transform(const arma::mat& data)
     {
-        std::cout << "\n[Transform] Applying stored normalization parameters..." << std::endl;
+        if (verbose)
+            std::cout << "\n[Transform] Applying stored normalization parameters..." << std::endl;
 
         if (minValues.is_empty() || maxValues.is_empty())
         {
             std::cerr << "⚠️ [Transform] Parameters not loaded — returning unmodified data." << std::endl;
             return data;
         }
+        CheckRows(data, "Transform");
 
-        arma::mat normalizedData = data;
-
-        for (arma::uword i = 0; i < data.n_rows; ++i)
-        {
-            double minVal = minValues(i);
-            double maxVal = maxValues(i);
-            double range = maxVal - minVal;
-
-            if (!arma::is_finite(minVal) || !arma::is_finite(maxVal) || range <= 1e-12)
-            {
-                std::cerr << "⚠️ [Transform] Invalid or zero range at row " << i
-                          << " — setting row to zeros." << std::endl;
-                normalizedData.row(i).zeros();
-                continue;
-            }
-
-            normalizedData.row(i) = (data.row(i) - minVal) / range;
-        }
+        const arma::colvec scale = ForwardScale("Transform", false);
+        arma::mat normalizedData = Scale<true>(data, minValues, scale);
+        ZeroInvalidRows(normalizedData, scale);
 
-        std::cout << "[Transform] Done." << std::endl;
+        if (verbose)
+            std::cout << "[Transform] Done." << std::endl;
         return normalizedData;
     }
 
@@ -126,24 +229,20 @@ public:
     // ───────────────────────────────────────────────
     arma::mat inverseTransform(const arma::mat& normalizedData)
     {
-        std::cout << "\n[InverseTransform] Reverting normalization..." << std::endl;
+        if (verbose)
+            std::cout << "\n[InverseTransform] Reverting normalization..." << std::endl;
 
         if (minValues.is_empty() || maxValues.is_empty())
         {
             throw std::runtime_error("❌ [InverseTransform] Normalization parameters not loaded!");
         }
+        CheckRows(normalizedData, "InverseTransform");
 
-        arma::mat originalData = normalizedData;
-        for (arma::uword i = 0; i < normalizedData.n_rows; ++i)
-        {
-            double minVal = minValues(i);
-            double maxVal = maxValues(i);
-            double range = maxVal - minVal;
-
-            originalData.row(i) = normalizedData.row(i) * range + minVal;
-        }
+        const arma::colvec range = maxValues - minValues;
+        arma::mat originalData = Scale<false>(normalizedData, minValues, range);
 
-        std::cout << "[InverseTransform] Completed successfully." << std::endl;
+        if (verbose)
+            std::cout << "[InverseTransform] Completed successfully." << std::endl;
         return originalData;
     }
 
@@ -152,7 +251,8 @@ public:
     // ───────────────────────────────────────────────
     void saveParameters(const std::string& filename)
     {
-        std::cout << "\n[SaveParams] Saving normalization parameters → " << filename << std::endl;
+        if (verbose)
+            std::cout << "\n[SaveParams] Saving normalization parameters → " << filename << std::endl;
         std::ofstream file(filename);
         if (!file.is_open())
         {
@@ -165,7 +265,8 @@ public:
         file << "\n";
 
         file.close();
-        std::cout << "[SaveParams] Saved " << minValues.n_elem << " min/max pairs." << std::endl;
+        if (verbose)
+            std::cout << "[SaveParams] Saved " << minValues.n_elem << " min/max pairs." << std::endl;
     }
 
     // ───────────────────────────────────────────────
@@ -173,7 +274,8 @@ public:
     // ───────────────────────────────────────────────
     void loadParameters(const std::string& filename)
     {
-        std::cout << "\n[LoadParams] Loading normalization parameters ← " << filename << std::endl;
+        if (verbose)
+            std::cout << "\n[LoadParams] Loading normalization parameters ← " << filename << std::endl;
         minValues.clear();
         maxValues.clear();
 
@@ -205,14 +307,24 @@ public:
         minValues = arma::colvec(minVals);
         maxValues = arma::colvec(maxVals);
 
-        std::cout << "[LoadParams] Loaded " << minValues.n_elem << " parameters." << std::endl;
+        if (verbose)
+            std::cout << "[LoadParams] Loaded " << minValues.n_elem << " parameters." << std::endl;
     }
 
     // ───────────────────────────────────────────────
-    // Getters
+    // Getters / Setters
     // ───────────────────────────────────────────────
     arma::colvec GetMinValues() const { return minValues; }
     arma::colvec GetMaxValues() const { return maxValues; }
+
+    void SetParameters(const arma::colvec& minVals, const arma::colvec& maxVals)
+    {
+        if (minVals.n_elem != maxVals.n_elem)
+            throw std::invalid_argument("❌ [SetParams] min/max vectors differ in size!");
+
+        minValues = minVals;
+        maxValues = maxVals;
+    }
 };
 
 #endif // CTRANSFORMATION_H
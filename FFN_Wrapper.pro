@@ -26,6 +26,8 @@ DEFINES += MLPACK_ENABLE_ANN_SERIALIZATION
 # ---------------- Compiler & Linker Flags ----------------
 QMAKE_CXXFLAGS += -fopenmp -O2
 QMAKE_LFLAGS   += -fopenmp
+# Lets the "omp simd" loops (e.g. CTransformation) use AVX2/AVX-512 of the build machine:
+# QMAKE_CXXFLAGS += -march=native
 
 # ---------------- Project Paths ----------------
 PowerEdge {
@@ -62,14 +64,23 @@ CONFIG  += use_VTK
 # ---------------- Source Files ----------------
 SOURCES += \
     $$OHQPATH/Utilities.cpp \
+    batchscorer.cpp \
+    bayesopt.cpp \
+    benchmark.cpp \
     cmodelstructure.cpp \
     cmodelstructure_multi.cpp \
     config.cpp \
+    datacache.cpp \
     ffnwrapper.cpp \
     ffnwrapper_multi.cpp \
+    fitnesscache.cpp \
+    gacheckpoint.cpp \
+    lagembedding.cpp \
     modelbuilder.cpp \
     modelcreator.cpp \
     main.cpp \
+    metrics.cpp \
+    streamingpredictor.cpp \
     trainer.cpp
 
 # ---------------- Header Files ----------------
@@ -79,18 +90,31 @@ HEADERS += \
     ../Utilities/BTCSet.h \
     ../Utilities/BTCSet.hpp \
     Binary.h \
+    batchscorer.h \
+    bayesopt.h \
+    benchmark.h \
+    boundedqueue.h \
     CTransformation.h \
     config.h \
+    datacache.h \
+    earlystopping.h \
     ga.h \
+    gacheckpoint.h \
     ga.hpp \
     individual.h \
+    inferenceengine.h \
+    inferenceengine.hpp \
     cmodelstructure.h \
     cmodelstructure_multi.h \
     ffnwrapper.h \
     ffnwrapper_multi.h \
+    fitnesscache.h \
+    lagembedding.h \
+    metrics.h \
     modelbuilder.h \
     modelcreator.h \
     pch.h \
+    streamingpredictor.h \
     trainer.h
 
 # ---------------- Build Notes ----------------
@@ -0,0 +1,175 @@
+/**
+ * @file batchscorer.cpp
+ * @brief Implements the batch-scoring pipeline (see batchscorer.h).
+ */
+
+#include "batchscorer.h"
+#include "boundedqueue.h"
+#include "datacache.h"
+#include "inferenceengine.h"
+#include "lagembedding.h"
+
+#include <BTCSet.h>
+#include <QDebug>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <thread>
+
+namespace
+{
+    /// One input file on its way through the pipeline.
+    struct CScoringJob
+    {
+        size_t index = 0;
+        CDataTable table;       // stage 1 → 2
+        arma::mat X;            // stage 2 → 3, lagged inputs
+        arma::vec t;            // time of every column of X
+    };
+
+    /// <stem>_predicted.txt per input; stems shared by several inputs get the input index appended
+    std::vector<std::string> OutputAddresses(const std::string& outputDirectory, const std::vector<std::string>& inputFiles)
+    {
+        std::map<std::string, int> stemCount;
+        for (const std::string& address : inputFiles)
+            ++stemCount[std::filesystem::path(address).stem().string()];
+
+        std::vector<std::string> outputs;
+        for (size_t i = 0; i < inputFiles.size(); ++i)
+        {
+            const std::string stem = std::filesystem::path(inputFiles[i]).stem().string();
+            const std::string name = stemCount[stem] > 1 ? stem + "_" + std::to_string(i) : stem;
+            outputs.push_back((std::filesystem::path(outputDirectory) / (name + "_predicted.txt")).string());
+        }
+        return outputs;
+    }
+}
+
+bool RunBatchScoring(const Config& cfg)
+{
+    const int scored = ScoreFiles(cfg.score_model, cfg.score_files, cfg.score_outputpath,
+                                  static_cast<unsigned int>(std::max(cfg.n_threads, 1)));
+    return scored == static_cast<int>(cfg.score_files.size());
+}
+
+int ScoreFiles(const std::string& modelFile,
+               const std::vector<std::string>& inputFiles,
+               const std::string& outputDirectory,
+               unsigned int threads)
+{
+    // ───────────────────────────────────────────────
+    // 1️⃣ Model: lags and columns from the bundle, weights into the engine
+    // ───────────────────────────────────────────────
+    FFNWrapper_Multi model;
+    model.ModelStructure.GA = true;     // quiet logging
+    CInferenceEngine<double> engine;
+    if (!model.LoadModel(modelFile) || !engine.Load(model))
+    {
+        qWarning() << "[Scoring] ❌ Could not load model" << QString::fromStdString(modelFile);
+        return -1;
+    }
+
+    const std::vector<int> inputcolumns = model.ModelStructure.inputcolumns;
+    const std::vector<std::vector<int>> lags = model.ModelStructure.lags;
+    const int maxLag = MaxLag(lags);
+    const size_t n_outputs = engine.OutputSize();
+
+    std::error_code error;
+    std::filesystem::create_directories(outputDirectory, error);
+    const std::vector<std::string> outputAddresses = OutputAddresses(outputDirectory, inputFiles);
+
+    // ───────────────────────────────────────────────
+    // 2️⃣ Stage sizes: one predict/write thread, the rest split between parse and lag
+    // ───────────────────────────────────────────────
+    const unsigned int parseWorkers = std::max(1u, (threads > 1 ? threads - 1 : 1) / 2);
+    const unsigned int lagWorkers = std::max(1u, (threads > 1 ? threads - 1 : 1) - parseWorkers);
+
+    CBoundedQueue<CScoringJob> parsed(2 * lagWorkers);
+    CBoundedQueue<CScoringJob> lagged(2);
+
+    qInfo() << "[Scoring]" << inputFiles.size() << "files," << parseWorkers << "parse +"
+            << lagWorkers << "lag threads";
+
+    std::atomic<size_t> nextFile{0};
+    std::atomic<unsigned int> parsersLeft{parseWorkers};
+    std::atomic<unsigned int> laggersLeft{lagWorkers};
+    std::atomic<int> failed{0};
+
+    auto parse = [&]()
+    {
+        for (size_t i = nextFile++; i < inputFiles.size(); i = nextFile++)
+        {
+            CScoringJob job;
+            job.index = i;
+            if (!job.table.Load(inputFiles[i]))
+            {
+                qWarning() << "[Scoring] ❌ Could not read" << QString::fromStdString(inputFiles[i]);
+                ++failed;
+                continue;
+            }
+            parsed.Push(std::move(job));
+        }
+        if (--parsersLeft == 0)
+            parsed.Close();
+    };
+
+    auto lag = [&]()
+    {
+        CScoringJob job;
+        while (parsed.Pop(job))
+        {
+            BuildLaggedMatrix(job.table.columns, inputcolumns, lags, maxLag, job.X);
+            if (job.X.n_cols == 0)
+            {
+                qWarning() << "[Scoring] ❌ No complete lag window in"
+                           << QString::fromStdString(inputFiles[job.index]);
+                ++failed;
+                continue;
+            }
+            // Gaps in the archive become 0, as Shifter() cleans the training inputs
+            job.X.elem(arma::find_nonfinite(job.X)).zeros();
+            job.t = job.table.t.subvec(maxLag, job.table.t.n_elem - 1);
+            job.table = CDataTable();   // free the raw columns before queueing
+            lagged.Push(std::move(job));
+        }
+        if (--laggersLeft == 0)
+            lagged.Close();
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int w = 0; w < parseWorkers; ++w)
+        workers.emplace_back(parse);
+    for (unsigned int w = 0; w < lagWorkers; ++w)
+        workers.emplace_back(lag);
+
+    // ───────────────────────────────────────────────
+    // 3️⃣ Predict and write on this thread, in completion order
+    // ───────────────────────────────────────────────
+    int scored = 0;
+    CScoringJob job;
+    arma::mat prediction;
+    while (lagged.Pop(job))
+    {
+        engine.Predict(job.X, prediction);
+
+        CTimeSeriesSet<double> output(static_cast<int>(n_outputs));
+        for (size_t k = 0; k < n_outputs; ++k)
+            for (arma::uword j = 0; j < prediction.n_cols; ++j)
+                output.BTC[k].append(job.t(j), prediction(k, j));
+
+        const std::string& address = outputAddresses[job.index];
+        output.writetofile(address);
+        ++scored;
+
+        qInfo() << "[Scoring]" << QString::fromStdString(inputFiles[job.index]) << "→"
+                << QString::fromStdString(address) << "(" << prediction.n_cols << "samples)";
+    }
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    qInfo() << "[Scoring] Scored" << scored << "of" << inputFiles.size() << "files,"
+            << failed.load() << "failed";
+    return scored;
+}
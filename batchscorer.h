@@ -0,0 +1,62 @@
+/**
+ * @file batchscorer.h
+ * @brief Declares the batch-scoring mode: predictions of a saved model for
+ *        many input files.
+ *
+ * @details
+ * Scoring archived data file by file is dominated by parsing, during which the
+ * network sits idle. ScoreFiles() overlaps the work of different files in a
+ * three-stage pipeline connected by bounded queues:
+ *
+ * @code
+ *   parse  (CDataTable::Load)      ×  P threads
+ *      │   CBoundedQueue
+ *   lag    (BuildLaggedMatrix)     ×  L threads
+ *      │   CBoundedQueue
+ *   predict + write                ×  1 thread (OpenMP inside Predict)
+ * @endcode
+ *
+ * Input scaling is applied inside the CInferenceEngine kernels, so it costs no
+ * separate pass. The queues hold at most two files per stage worker, which
+ * bounds memory independently of the number of files. Each result is written
+ * as soon as its file has been predicted, so files complete out of order.
+ *
+ * For every input file @c name.ext the output @c name_predicted.txt holds the
+ * model outputs at the time steps that have a complete lag window. When
+ * several inputs share a name, the index of the input is appended
+ * (@c name_<index>_predicted.txt) so no output overwrites another. Missing or
+ * infinite inputs are replaced by 0, as in Shifter().
+ *
+ * @see RunBatchScoring()
+ * @see FFNWrapper_Multi::SaveModel()
+ */
+
+#pragma once
+
+#include "config.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Score @c cfg.score_files with the bundle @c cfg.score_model.
+ *
+ * @details Results go to @c cfg.score_outputpath; @c cfg.n_threads bounds the
+ *          number of pipeline threads.
+ * @return false if the model could not be loaded or any file failed.
+ */
+bool RunBatchScoring(const Config& cfg);
+
+/**
+ * @brief Predict every file of @p inputFiles with the model bundle @p modelFile.
+ *
+ * @param modelFile       Bundle written by FFNWrapper_Multi::SaveModel().
+ * @param inputFiles      Data files laid out like the training files.
+ * @param outputDirectory Directory for the *_predicted.txt files.
+ * @param threads         Pipeline threads (at least 3 are used).
+ * @return Number of files scored successfully, or -1 if the model could not be loaded.
+ */
+int ScoreFiles(const std::string& modelFile,
+               const std::vector<std::string>& inputFiles,
+               const std::string& outputDirectory,
+               unsigned int threads);
@@ -0,0 +1,145 @@
+/**
+ * @file bayesopt.cpp
+ * @brief Implements the Bayesian-search surrogate (see bayesopt.h).
+ */
+
+#include "bayesopt.h"
+#include "modelcreator.h"
+
+#include <cmath>
+#include <limits>
+
+// ======================================================================
+//  Structure features
+// ======================================================================
+
+arma::vec StructureFeatures(const CModelStructure_Multi &structure, const ModelCreator &creator)
+{
+    const int n_columns = creator.total_number_of_columns;
+    const int n_slots = creator.max_number_of_layers + 1;
+    arma::vec features(2 * n_columns + 1 + n_slots, arma::fill::zeros);
+
+    for (size_t i = 0; i < structure.inputcolumns.size(); i++)
+    {
+        const int column = structure.inputcolumns[i];
+        if (column < 0 || column >= n_columns)
+            continue;
+        features(column) = 1.0;
+        if (i < structure.lags.size())
+            features(n_columns + column) =
+                static_cast<double>(structure.lags[i].size()) / std::max(creator.maximum_superficial_lag, 1);
+    }
+
+    features(2 * n_columns) =
+        static_cast<double>(structure.input_lag_multiplier) / std::max(creator.max_lag_multiplier, 1);
+
+    for (int l = 0; l < n_slots && l < static_cast<int>(structure.n_nodes.size()); l++)
+        features(2 * n_columns + 1 + l) =
+            static_cast<double>(structure.n_nodes[l]) / std::max(creator.max_number_of_nodes_in_layers, 1);
+
+    return features;
+}
+
+// ======================================================================
+//  Gaussian process
+// ======================================================================
+
+double CGaussianProcess::Kernel(const arma::vec &a, const arma::vec &b, double scale) const
+{
+    return std::exp(-0.5 * arma::accu(arma::square(a - b)) / (scale * scale));
+}
+
+bool CGaussianProcess::Fit(const arma::mat &features, const arma::vec &y)
+{
+    const arma::uword n = features.n_cols;
+    if (n == 0 || y.n_elem != n)
+        return false;
+
+    double mean = arma::mean(y);
+    double sd = (n > 1) ? arma::stddev(y) : 1.0;
+    if (!(sd > 1e-12))
+        sd = 1.0;
+    const arma::vec z = (y - mean) / sd;
+
+    // Length scale from a grid, by log marginal likelihood
+    const double dimension = std::sqrt(static_cast<double>(std::max<arma::uword>(features.n_rows, 1)));
+    const double grid[] = {0.05, 0.1, 0.2, 0.4, 0.8};
+
+    double bestLikelihood = -std::numeric_limits<double>::infinity();
+    double bestScale = lengthScale;
+    arma::mat bestL;
+    arma::vec bestAlpha;
+    arma::mat K(n, n);
+    for (double g : grid)
+    {
+        const double scale = g * dimension;
+        for (arma::uword i = 0; i < n; i++)
+        {
+            K(i, i) = 1.0 + noise;
+            for (arma::uword j = 0; j < i; j++)
+                K(i, j) = K(j, i) = Kernel(features.col(i), features.col(j), scale);
+        }
+
+        arma::mat factor;
+        if (!arma::chol(factor, K, "lower"))
+            continue;
+
+        const arma::vec a = arma::solve(arma::trimatu(factor.t()), arma::solve(arma::trimatl(factor), z));
+        const double likelihood = -0.5 * arma::dot(z, a) - arma::accu(arma::log(factor.diag()));
+        if (likelihood > bestLikelihood)
+        {
+            bestLikelihood = likelihood;
+            bestScale = scale;
+            bestL = factor;
+            bestAlpha = a;
+        }
+    }
+
+    // Commit only a consistent state: X, L and alpha always describe the same observations
+    if (!std::isfinite(bestLikelihood))
+    {
+        X.reset();
+        L.reset();
+        alpha.reset();
+        return false;
+    }
+
+    X = features;
+    yMean = mean;
+    ySd = sd;
+    lengthScale = bestScale;
+    L = bestL;
+    alpha = bestAlpha;
+    return true;
+}
+
+void CGaussianProcess::Predict(const arma::vec &x, double &mean, double &sd) const
+{
+    if (alpha.is_empty())
+    {
+        mean = yMean;
+        sd = ySd;
+        return;
+    }
+
+    arma::vec k(X.n_cols);
+    for (arma::uword i = 0; i < X.n_cols; i++)
+        k(i) = Kernel(x, X.col(i), lengthScale);
+
+    const arma::vec v = arma::solve(arma::trimatl(L), k);
+    const double variance = std::max(1.0 - arma::dot(v, v), 1e-12);
+
+    mean = yMean + ySd * arma::dot(k, alpha);
+    sd = ySd * std::sqrt(variance);
+}
+
+double ExpectedImprovement(double mean, double sd, double best)
+{
+    if (sd <= 0)
+        return std::max(best - mean, 0.0);
+
+    const double z = (best - mean) / sd;
+    const double cdf = 0.5 * std::erfc(-z / std::sqrt(2.0));
+    const double pdf = std::exp(-0.5 * z * z) / std::sqrt(2.0 * M_PI);
+    return (best - mean) * cdf + sd * pdf;
+}
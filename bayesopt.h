@@ -0,0 +1,81 @@
+/**
+ * @file bayesopt.h
+ * @brief Declares the surrogate model used by the Bayesian structure search:
+ *        structure features, a Gaussian process and expected improvement.
+ *
+ * @details
+ * RunBayesian() needs a cheap predictor of the fitness of a structure that has
+ * not been trained yet. Structures are described by a fixed-length feature
+ * vector in [0, 1]^d (StructureFeatures()):
+ *
+ * | Features                        | Count                  | Scaling                          |
+ * |---------------------------------|------------------------|----------------------------------|
+ * | column selected                 | total_number_of_columns| 0 / 1                            |
+ * | number of lags of the column    | total_number_of_columns| / maximum_superficial_lag        |
+ * | lag multiplier                  | 1                      | / max_lag_multiplier             |
+ * | width of hidden layer i         | max_number_of_layers+1 | / max_number_of_nodes_in_layers  |
+ *
+ * CGaussianProcess fits a zero-mean GP with a squared-exponential kernel to
+ * the standardized log fitness of the trained structures. The length scale is
+ * chosen from a small grid by log marginal likelihood on every Fit().
+ * ExpectedImprovement() scores candidates for minimization.
+ *
+ * @see RunBayesian()
+ */
+
+#pragma once
+
+#include <armadillo>
+
+#include "cmodelstructure_multi.h"
+
+class ModelCreator;
+
+/**
+ * @brief Feature vector of a decoded structure, see the table above.
+ */
+arma::vec StructureFeatures(const CModelStructure_Multi &structure, const ModelCreator &creator);
+
+/**
+ * @class CGaussianProcess
+ * @brief Gaussian-process regression with a squared-exponential kernel.
+ */
+class CGaussianProcess
+{
+public:
+
+    /**
+     * @brief Condition the GP on observations.
+     *
+     * @param X Features, one column per observation.
+     * @param y Observed values (standardized internally).
+     * @return false if there are no observations or no length scale gives a
+     *         positive-definite kernel matrix; the GP is then empty and
+     *         Predict() returns the prior of the last successful fit.
+     */
+    bool Fit(const arma::mat &X, const arma::vec &y);
+
+    /**
+     * @brief Posterior mean and standard deviation at @p x, in the units of y.
+     */
+    void Predict(const arma::vec &x, double &mean, double &sd) const;
+
+    double LengthScale() const { return lengthScale; }
+
+    double noise = 1e-3;            ///< Observation noise variance, relative to the standardized signal.
+
+private:
+    double Kernel(const arma::vec &a, const arma::vec &b, double scale) const;
+
+    arma::mat X;
+    arma::mat L;                    ///< Lower Cholesky factor of K + noise I.
+    arma::vec alpha;                ///< (K + noise I)^-1 (y - mean) / sd
+    double yMean = 0.0;
+    double ySd = 1.0;
+    double lengthScale = 0.5;
+};
+
+/**
+ * @brief Expected improvement below @p best of a normal prediction (mean, sd).
+ */
+double ExpectedImprovement(double mean, double sd, double best);
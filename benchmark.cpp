@@ -0,0 +1,379 @@
+/**
+ * @file benchmark.cpp
+ * @brief Implements the micro-benchmarks declared in benchmark.h.
+ */
+
+#include "benchmark.h"
+#include "datacache.h"
+#include "inferenceengine.h"
+#include "lagembedding.h"
+
+#include <BTCSet.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double SecondsSince(const Clock::time_point &start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+}
+
+bool RunBenchmark(const CModelStructure_Multi& ms, const Config& cfg)
+{
+    arma::arma_rng::set_seed(static_cast<arma::arma_rng::seed_type>(cfg.Seed_number));
+
+    if (cfg.benchmark == "lag")
+    {
+        BenchmarkLagEmbedding();
+        return true;
+    }
+    if (cfg.benchmark == "batch")
+    {
+        BenchmarkBatchSize(ms);
+        return true;
+    }
+    if (cfg.benchmark == "latency")
+    {
+        BenchmarkInferenceLatency(ms);
+        return true;
+    }
+    if (cfg.benchmark == "precision")
+    {
+        BenchmarkPrecision(ms);
+        return true;
+    }
+    if (cfg.benchmark == "cache")
+        return BenchmarkDataCache(ms);
+
+    std::cerr << "[Benchmark] Unknown benchmark: " << cfg.benchmark << std::endl;
+    return false;
+}
+
+// ======================================================================
+//  Lag embedding
+// ======================================================================
+
+void BenchmarkLagEmbedding(int n_inputs, int n_lags, int n_steps)
+{
+    std::cout << "[Benchmark] Lag embedding: " << n_inputs << " inputs x " << n_lags
+              << " lags x " << n_steps << " time steps" << std::endl;
+
+    // Synthetic series: inputs in columns 0..n_inputs-1, target in the last column
+    arma::mat series = arma::cumsum(arma::randn<arma::mat>(n_steps, n_inputs + 1));
+
+    std::vector<int> inputcolumns(n_inputs);
+    std::vector<std::vector<int>> lags(n_inputs);
+    for (int i = 0; i < n_inputs; i++)
+    {
+        inputcolumns[i] = i;
+        for (int l = 0; l < n_lags; l++)
+            lags[i].push_back(l);
+    }
+    const std::vector<int> outputcolumns = {n_inputs};
+    const int maxLag = MaxLag(lags);
+
+    CTimeSeriesSet<double> TimeSeries(n_inputs + 1);
+    for (int v = 0; v <= n_inputs; v++)
+        for (int t = 0; t < n_steps; t++)
+            TimeSeries.BTC[v].append(t, series(t, v));
+
+    // Legacy path: shift through CTimeSeriesSet, then trim the first maxLag samples
+    Clock::time_point start = Clock::now();
+    arma::mat LegacyX = TimeSeries.ToArmaMatShifter(inputcolumns, lags);
+    arma::mat LegacyY = TimeSeries.ToArmaMatShifterOutput(outputcolumns, lags);
+    if (maxLag > 0 && LegacyX.n_cols > static_cast<arma::uword>(maxLag))
+    {
+        LegacyX = LegacyX.cols(maxLag, LegacyX.n_cols - 1);
+        LegacyY = LegacyY.cols(maxLag, LegacyY.n_cols - 1);
+    }
+    const double legacySeconds = SecondsSince(start);
+
+    // Lag-embedding kernel
+    arma::mat X, Y;
+    start = Clock::now();
+    BuildLaggedMatrix(series, inputcolumns, lags, maxLag, X);
+    BuildTargetMatrix(series, outputcolumns, maxLag, Y);
+    const double kernelSeconds = SecondsSince(start);
+
+    double maxDifference = -1.0;
+    if (arma::size(X) == arma::size(LegacyX) && arma::size(Y) == arma::size(LegacyY))
+        maxDifference = std::max(arma::abs(X - LegacyX).max(), arma::abs(Y - LegacyY).max());
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "  X: " << X.n_rows << " x " << X.n_cols << "\n"
+              << "  ToArmaMatShifter + trim : " << legacySeconds << " s\n"
+              << "  BuildLaggedMatrix       : " << kernelSeconds << " s\n"
+              << "  Speed-up                : " << legacySeconds / std::max(kernelSeconds, 1e-9) << "x\n"
+              << std::scientific
+              << "  Max |difference|        : " << maxDifference
+              << (maxDifference < 0 ? " (shape mismatch)" : "") << std::endl;
+}
+
+// ======================================================================
+//  Mini-batch size
+// ======================================================================
+
+void BenchmarkBatchSize(const CModelStructure_Multi& ms, size_t epochs)
+{
+    CDataCache DataCache;
+    if (!DataCache.Load(ms))
+    {
+        std::cerr << "[Benchmark] Could not load the train/test data" << std::endl;
+        return;
+    }
+
+    std::cout << "[Benchmark] Mini-batch size (" << ms.training.optimizer << ", "
+              << epochs << " epochs per size)" << std::endl;
+    std::cout << std::setw(8) << "batch" << std::setw(16) << "samples/s"
+              << std::setw(12) << "time [s]" << std::setw(14) << "nMSE test" << std::endl;
+
+    for (size_t batch = 1; batch <= 1024; batch *= 2)
+    {
+        FFNWrapper_Multi F;
+        F.ModelStructure = ms;
+        F.ModelStructure.GA = true;     // quiet logging
+        F.ModelStructure.DataCache = &DataCache;
+        F.ModelStructure.training.batch_size = batch;
+        F.ModelStructure.training.epochs = epochs;
+        F.ModelStructure.training.early_stopping = false;   // every epoch runs on every sample
+        F.Initiate(false);
+
+        const Clock::time_point start = Clock::now();
+        F.Train();
+        const double seconds = SecondsSince(start);
+
+        // Train() predicts the whole training set, so this is the sample count
+        const double samples = static_cast<double>(epochs) * F.TrainDataPrediction.n_cols;
+
+        F.Test();
+        F.PerformanceMetrics();
+
+        std::cout << std::setw(8) << batch
+                  << std::setw(16) << std::fixed << std::setprecision(0) << samples / std::max(seconds, 1e-9)
+                  << std::setw(12) << std::setprecision(3) << seconds
+                  << std::setw(14) << std::setprecision(5) << (F.nMSE_Test.empty() ? -1.0 : F.nMSE_Test[0])
+                  << std::endl;
+    }
+}
+
+// ======================================================================
+//  Inference latency
+// ======================================================================
+
+void BenchmarkInferenceLatency(const CModelStructure_Multi& ms, size_t epochs, size_t calls)
+{
+    CDataCache DataCache;
+    if (!DataCache.Load(ms) || DataCache.Test().empty())
+    {
+        std::cerr << "[Benchmark] Could not load the train/test data" << std::endl;
+        return;
+    }
+
+    FFNWrapper_Multi F;
+    F.ModelStructure = ms;
+    F.ModelStructure.GA = true;     // quiet logging
+    F.ModelStructure.DataCache = &DataCache;
+    F.ModelStructure.training.epochs = epochs;
+    F.ModelStructure.training.early_stopping = false;
+    F.Initiate(false);
+    F.Train();
+
+    // Raw lagged inputs of the first test file, as Shifter() builds them
+    arma::mat X;
+    BuildLaggedMatrix(DataCache.Test()[0].columns, ms.inputcolumns, ms.lags, MaxLag(ms.lags), X);
+    if (X.n_cols == 0)
+    {
+        std::cerr << "[Benchmark] The test file holds no complete lag window" << std::endl;
+        return;
+    }
+    const arma::fmat Xf = arma::conv_to<arma::fmat>::from(X);
+
+    CInferenceEngine<double> engine(F);
+    CInferenceEngine<float> engineF(F);
+    if (!engine.IsLoaded() || !engineF.IsLoaded())
+    {
+        std::cerr << "[Benchmark] Could not load the network into the inference engine" << std::endl;
+        return;
+    }
+
+    std::cout << "[Benchmark] Inference latency: " << X.n_rows << " inputs, "
+              << X.n_cols << " test samples, " << calls << " single-sample calls per path" << std::endl;
+
+    // Reference predictions and accuracy of the engines
+    arma::mat reference, prediction;
+    arma::fmat predictionF;
+    F.Forecast(X, reference);
+    engine.Predict(X, prediction);
+    engineF.Predict(Xf, predictionF);
+    const double maxDifference = arma::abs(prediction - reference).max();
+    const double maxDifferenceF = arma::abs(arma::conv_to<arma::mat>::from(predictionF) - reference).max();
+
+    // Single-sample latency; the checksum keeps the calls from being optimized away
+    double checksum = 0.0;
+    arma::mat column, single;
+    Clock::time_point start = Clock::now();
+    for (size_t c = 0; c < calls; ++c)
+    {
+        column = X.col(c % X.n_cols);
+        F.Forecast(column, single);
+        checksum += single(0);
+    }
+    const double forecastSeconds = SecondsSince(start);
+
+    std::vector<double> output(engine.OutputSize());
+    start = Clock::now();
+    for (size_t c = 0; c < calls; ++c)
+    {
+        engine.Predict(X.colptr(c % X.n_cols), output.data());
+        checksum += output[0];
+    }
+    const double engineSeconds = SecondsSince(start);
+
+    std::vector<float> outputF(engineF.OutputSize());
+    start = Clock::now();
+    for (size_t c = 0; c < calls; ++c)
+    {
+        engineF.Predict(Xf.colptr(c % Xf.n_cols), outputF.data());
+        checksum += outputF[0];
+    }
+    const double engineFSeconds = SecondsSince(start);
+
+    auto micro = [calls](double seconds) { return 1e6 * seconds / static_cast<double>(calls); };
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "  Forecast()                : " << micro(forecastSeconds) << " us/sample\n"
+              << "  CInferenceEngine<double>  : " << micro(engineSeconds) << " us/sample ("
+              << forecastSeconds / std::max(engineSeconds, 1e-12) << "x)\n"
+              << "  CInferenceEngine<float>   : " << micro(engineFSeconds) << " us/sample ("
+              << forecastSeconds / std::max(engineFSeconds, 1e-12) << "x)\n"
+              << std::scientific
+              << "  Max |difference| double   : " << maxDifference << "\n"
+              << "  Max |difference| float    : " << maxDifferenceF << "\n"
+              << "  (checksum " << checksum << ")" << std::endl;
+}
+
+// ======================================================================
+//  Double vs. single precision
+// ======================================================================
+
+void BenchmarkPrecision(const CModelStructure_Multi& ms, size_t epochs, size_t repeats)
+{
+    CDataCache DataCache;
+    if (!DataCache.Load(ms))
+    {
+        std::cerr << "[Benchmark] Could not load the train/test data" << std::endl;
+        return;
+    }
+
+#if MLPACK_VERSION_MAJOR < 4
+    std::cerr << "[Benchmark] Single precision needs mlpack 4; both runs train in double" << std::endl;
+#endif
+
+    std::cout << "[Benchmark] Precision (" << ms.training.optimizer << ", "
+              << epochs << " epochs)" << std::endl;
+    std::cout << std::setw(10) << "precision" << std::setw(16) << "train [1/s]"
+              << std::setw(16) << "predict [1/s]" << std::setw(14) << "nMSE test" << std::endl;
+
+    arma::mat predictions[2];
+    for (int single = 0; single < 2; single++)
+    {
+        FFNWrapper_Multi F;
+        F.ModelStructure = ms;
+        F.ModelStructure.GA = true;     // quiet logging
+        F.ModelStructure.DataCache = &DataCache;
+        F.ModelStructure.training.epochs = epochs;
+        F.ModelStructure.training.early_stopping = false;   // both runs fit every sample for every epoch
+        F.ModelStructure.training.single_precision = (single == 1);
+        F.Initiate(false);
+
+        Clock::time_point start = Clock::now();
+        F.Train();
+        const double trainSeconds = SecondsSince(start);
+        // Samples actually fitted: no early stopping, so every epoch covers the training set
+        const double trainSamples = static_cast<double>(epochs) * F.TrainDataPrediction.n_cols;
+
+        // Test-set prediction, best of several passes
+        double predictSeconds = std::numeric_limits<double>::infinity();
+        for (size_t r = 0; r < repeats; r++)
+        {
+            start = Clock::now();
+            F.Test();
+            predictSeconds = std::min(predictSeconds, SecondsSince(start));
+        }
+        F.PerformanceMetrics();
+        predictions[single] = F.TestDataPrediction;
+
+        std::cout << std::setw(10) << (single ? "float" : "double")
+                  << std::setw(16) << std::fixed << std::setprecision(0) << trainSamples / std::max(trainSeconds, 1e-9)
+                  << std::setw(16) << F.TestDataPrediction.n_cols / std::max(predictSeconds, 1e-9)
+                  << std::setw(14) << std::setprecision(5) << (F.nMSE_Test.empty() ? -1.0 : F.nMSE_Test[0])
+                  << std::endl;
+    }
+
+    if (predictions[0].n_elem > 0 && arma::size(predictions[0]) == arma::size(predictions[1]))
+        std::cout << std::scientific << "  Max |prediction difference| : "
+                  << arma::abs(predictions[1] - predictions[0]).max() << std::endl;
+    std::cout << "  (float prediction includes converting the test matrix to float and the prediction back)"
+              << std::endl;
+}
+
+// ======================================================================
+//  Data cache consistency
+// ======================================================================
+
+bool BenchmarkDataCache(const CModelStructure_Multi& ms)
+{
+    CDataCache DataCache;
+    Clock::time_point start = Clock::now();
+    if (!DataCache.Load(ms))
+    {
+        std::cerr << "[Benchmark] Could not load the train/test data" << std::endl;
+        return false;
+    }
+    const double loadSeconds = SecondsSince(start);
+
+    FFNWrapper_Multi Files, Cached;
+    Files.ModelStructure = ms;
+    Files.ModelStructure.GA = true;     // quiet logging
+    Files.ModelStructure.DataCache = nullptr;
+    Cached.ModelStructure = Files.ModelStructure;
+    Cached.ModelStructure.DataCache = &DataCache;
+
+    start = Clock::now();
+    Files.Initiate(false);
+    const double filesSeconds = SecondsSince(start);
+
+    start = Clock::now();
+    Cached.Initiate(false);
+    const double cachedSeconds = SecondsSince(start);
+
+    auto difference = [](const arma::mat& a, const arma::mat& b)
+    {
+        if (arma::size(a) != arma::size(b))
+            return arma::datum::inf;
+        return a.is_empty() ? 0.0 : arma::abs(a - b).max();
+    };
+    const double trainDifference = difference(Files.TrainInputs(), Cached.TrainInputs());
+    const double testDifference = difference(Files.TestInputs(), Cached.TestInputs());
+
+    std::cout << "[Benchmark] Data preparation: " << Files.TrainInputs().n_rows << " inputs, "
+              << Files.TrainInputs().n_cols << " train / " << Files.TestInputs().n_cols << " test samples\n"
+              << std::fixed << std::setprecision(3)
+              << "  Files (RunSingle)        : " << filesSeconds << " s\n"
+              << "  Cache load (once per run): " << loadSeconds << " s\n"
+              << "  Cached (per candidate)   : " << cachedSeconds << " s\n"
+              << std::scientific
+              << "  Max |difference| train   : " << trainDifference << "\n"
+              << "  Max |difference| test    : " << testDifference << std::endl;
+
+    const bool identical = trainDifference == 0.0 && testDifference == 0.0;
+    if (!identical)
+        std::cerr << "[Benchmark] ❌ Cached and file inputs differ" << std::endl;
+    return identical;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file benchmark.h
+ * @brief Declares the micro-benchmarks selectable through Config::benchmark.
+ *
+ * @details
+ * Benchmarks run instead of a training mode when @c cfg.benchmark is not
+ * empty and print their timings to the console. "lag" uses synthetic data;
+ * the others use the model structure and data files built in main.cpp.
+ *
+ * | cfg.benchmark | Function                 | Measures                                   |
+ * |---------------|--------------------------|--------------------------------------------|
+ * | "lag"         | BenchmarkLagEmbedding()  | Lagged design-matrix construction          |
+ * | "batch"       | BenchmarkBatchSize()     | Training throughput per mini-batch size    |
+ * | "latency"     | BenchmarkInferenceLatency() | Single-sample prediction latency        |
+ * | "precision"   | BenchmarkPrecision()     | Double vs. single-precision training       |
+ * | "cache"       | BenchmarkDataCache()     | Data preparation with/without CDataCache   |
+ *
+ * @see RunBenchmark()
+ */
+
+#pragma once
+
+#include "config.h"
+
+/**
+ * @brief Run the benchmark named by @c cfg.benchmark.
+ *
+ * @param ms  Model structure with addresses (see BuildAddresses()).
+ * @param cfg Configuration (@c benchmark, @c Seed_number and @c training are used).
+ * @return false if @c cfg.benchmark does not name a known benchmark.
+ */
+bool RunBenchmark(const CModelStructure_Multi& ms, const Config& cfg);
+
+/**
+ * @brief Compare lag-matrix construction through CTimeSeriesSet with BuildLaggedMatrix().
+ *
+ * @details
+ * The legacy path is the one Shifter() used before the lag-embedding kernel:
+ * ToArmaMatShifter() / ToArmaMatShifterOutput() followed by dropping the first
+ * maxLag samples with X.cols(maxLag, ...). Both paths build the same design
+ * matrix from the same synthetic series; the maximum absolute difference is
+ * reported as a consistency check.
+ *
+ * @param n_inputs Number of input variables.
+ * @param n_lags   Lags per input (0, 1, ..., n_lags - 1).
+ * @param n_steps  Number of time steps.
+ *
+ * @warning The default size needs n_inputs × n_lags × n_steps × 8 bytes
+ *          (4 GB) per design matrix; the legacy path holds two of them.
+ */
+void BenchmarkLagEmbedding(int n_inputs = 10, int n_lags = 50, int n_steps = 1000000);
+
+/**
+ * @brief Training throughput of @p ms for mini-batch sizes 1, 2, 4, ..., 1024.
+ *
+ * @details
+ * Loads the train/test data of @p ms once, then for every batch size
+ * re-initializes the network with the same seed and trains it for
+ * @p epochs epochs with the optimizer of @c ms.training. Reports samples/s
+ * (epochs × training samples / wall time of Train(), which includes one
+ * forward pass over the training set) and the resulting test nMSE of the
+ * first output, so speed can be weighed against accuracy.
+ *
+ * @param ms     Model structure (e.g. the ASM structure built in main.cpp).
+ * @param epochs Epochs per batch size.
+ */
+void BenchmarkBatchSize(const CModelStructure_Multi& ms, size_t epochs = 2);
+
+/**
+ * @brief Single-sample prediction latency of FFNWrapper_Multi::Forecast() and CInferenceEngine.
+ *
+ * @details
+ * Trains @p ms once for @p epochs epochs, builds the raw lagged inputs of the
+ * first test file and predicts them one sample at a time, cycling through the
+ * samples for @p calls predictions per path:
+ *
+ * - Forecast(), i.e. the scalers and FFN::Predict() on a one-column matrix;
+ * - CInferenceEngine<double>;
+ * - CInferenceEngine<float>.
+ *
+ * Reports the mean latency in microseconds and the largest absolute
+ * difference of each engine from Forecast() over all test samples.
+ *
+ * @param ms     Model structure (e.g. the ASM structure built in main.cpp).
+ * @param epochs Training epochs; accuracy is irrelevant to the timing.
+ * @param calls  Single-sample predictions per path.
+ */
+void BenchmarkInferenceLatency(const CModelStructure_Multi& ms, size_t epochs = 1, size_t calls = 100000);
+
+/**
+ * @brief Accuracy and throughput of double- and single-precision training.
+ *
+ * @details
+ * Trains @p ms twice from the same seed, once on arma::mat and once with
+ * @c training.single_precision (arma::fmat), each for exactly @p epochs
+ * epochs (early stopping is turned off). The float prediction time includes
+ * the double/float conversion of the test matrix done by Test().
+ * Reports per precision the training throughput in samples/s, the test-set
+ * prediction throughput (best of @p repeats passes) and the test nMSE of the
+ * first output, then the largest absolute difference between the two test
+ * predictions.
+ *
+ * @param ms      Model structure (e.g. the ASM structure built in main.cpp).
+ * @param epochs  Training epochs per precision.
+ * @param repeats Test-set prediction passes timed per precision.
+ *
+ * @note Without mlpack 4 both runs train in double.
+ */
+void BenchmarkPrecision(const CModelStructure_Multi& ms, size_t epochs = 10, size_t repeats = 20);
+
+/**
+ * @brief Data preparation of @p ms with and without a CDataCache.
+ *
+ * @details
+ * Runs Initiate() once reading the files (as RunSingle() does) and once
+ * gathering from a CDataCache (as GA, random and Bayesian search do), and
+ * reports the time of each. Both paths must feed the network the same
+ * scaled inputs; the largest absolute difference of the train and test
+ * input matrices is reported and should be 0.
+ *
+ * @param ms Model structure (e.g. the ASM structure built in main.cpp).
+ * @return true if both paths produced identical input matrices.
+ */
+bool BenchmarkDataCache(const CModelStructure_Multi& ms);
@@ -0,0 +1,67 @@
+/**
+ * @file boundedqueue.h
+ * @brief Declares CBoundedQueue, a blocking FIFO of fixed capacity that links
+ *        the stages of a producer/consumer pipeline.
+ *
+ * @details
+ * Push() blocks while the queue is full, which bounds the memory held between
+ * two pipeline stages; Pop() blocks while it is empty. Close() marks the end
+ * of the stream: pending items are still delivered, then Pop() returns false.
+ *
+ * @see ScoreFiles()
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+template<typename T>
+class CBoundedQueue
+{
+public:
+    explicit CBoundedQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+    /// Append @p item, waiting for space. Returns false if the queue was closed.
+    bool Push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return closed || items.size() < capacity; });
+        if (closed)
+            return false;
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    /// Take the oldest item, waiting for one. Returns false once closed and drained.
+    bool Pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return closed || !items.empty(); });
+        if (items.empty())
+            return false;
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    /// No more items will be pushed; wakes every waiting thread.
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<T> items;
+    size_t capacity;
+    bool closed = false;
+};
@@ -1,6 +1,7 @@
 #include "cmodelstructure_multi.h"
 #include <QFile>
 #include <QTextStream>
+#include <QDir>
 
 CModelStructure_Multi::CModelStructure_Multi() //Default constructor
 {
@@ -11,6 +12,7 @@ CModelStructure_Multi::CModelStructure_Multi(const CModelStructure_Multi &rhs) /
 {
     InputTimeSeries = rhs.InputTimeSeries;
     TestTimeSeries = rhs.TestTimeSeries;
+    DataCache = rhs.DataCache;
     activation_function = rhs.activation_function;
     dt = rhs.dt;
     input_lag_multiplier = rhs.input_lag_multiplier;
@@ -32,14 +34,17 @@ CModelStructure_Multi::CModelStructure_Multi(const CModelStructure_Multi &rhs) /
     outputpath = rhs.outputpath;
     log_output = rhs.log_output;
     seed_number = rhs.seed_number;
+    training = rhs.training;
     GA = rhs.GA;
     preTransformed = rhs.preTransformed;
+    debug_level = rhs.debug_level;
 
 }
 CModelStructure_Multi& CModelStructure_Multi::operator = (const CModelStructure_Multi &rhs) // Operator =
 {
     InputTimeSeries = rhs.InputTimeSeries;
     TestTimeSeries = rhs.TestTimeSeries;
+    DataCache = rhs.DataCache;
     activation_function = rhs.activation_function;
     dt = rhs.dt;
     input_lag_multiplier = rhs.input_lag_multiplier;
@@ -61,8 +66,10 @@ CModelStructure_Multi& CModelStructure_Multi::operator = (const CModelStructure_
     outputpath = rhs.outputpath;
     log_output = rhs.log_output;
     seed_number = rhs.seed_number;
+    training = rhs.training;
     GA = rhs.GA;
     preTransformed = rhs.preTransformed;
+    debug_level = rhs.debug_level;
 
     return *this;
 }
@@ -128,3 +135,13 @@ QString CModelStructure_Multi::ParametersToString()
     return out;
 }
 
+
+bool CModelStructure_Multi::IsolateOutputPath(const string &slot)
+{
+    string isolated = outputpath + slot + "/";
+    if (!QDir().mkpath(QString::fromStdString(isolated)))
+        return false;
+
+    outputpath = isolated;
+    return true;
+}
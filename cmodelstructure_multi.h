@@ -7,6 +7,24 @@
 
 using namespace std;
 
+class CDataCache;
+
+// Optimizer settings used by FFNWrapper_Multi::Train()
+struct CTrainingConfig
+{
+    string optimizer = "Adam";   // "Adam", "SGD" or "RMSProp"
+    size_t batch_size = 32;      // samples per gradient step
+    size_t epochs = 10;          // passes over the training set (maximum when early stopping)
+    double learning_rate = 0.003;
+    double tolerance = 1e-8;
+    bool shuffle = true;
+    bool early_stopping = false; // stop when the loss on the held-out tail stops improving; keep the best weights
+    double validation_fraction = 0.1; // tail of the training window held out for early stopping
+    size_t patience = 3;         // epochs without improvement before stopping
+    double min_delta = 0.0;      // smallest validation-loss decrease that counts as improvement
+    bool single_precision = false; // train and predict in float (arma::fmat, mlpack 4); weights are copied to the double network
+};
+
 class CModelStructure_Multi
 {
 public:
@@ -15,6 +33,7 @@ public:
     CModelStructure_Multi& operator = (const CModelStructure_Multi &rhs);
     CTimeSeriesSet<double> *InputTimeSeries = nullptr; //(string& address, bool& tf);
     CTimeSeriesSet<double> *TestTimeSeries = nullptr; //(string& address, bool& tf);
+    const CDataCache *DataCache = nullptr; // shared raw train/test data (GA/RMS); nullptr = load files per candidate
     double dt;
     vector<string> trainaddress;
     vector<string> testaddress; //the number of test sets does not need to be equal to training sets
@@ -36,6 +55,7 @@ public:
     string outputpath;
     bool log_output = false;
     double seed_number = 42; // 42 is a random number
+    CTrainingConfig training;
     void Reset()
     {
         inputcolumns.clear();
@@ -60,6 +80,7 @@ public:
 
     bool WriteToFile(const QString &filename);
     QString ParametersToString();
+    bool IsolateOutputPath(const string &slot); // redirects outputpath into outputpath/slot/ so parallel workers never share files
     bool operator!=(const CModelStructure_Multi &m2)
     {
         return !(operator==(m2));
@@ -76,6 +97,7 @@ public:
 
     bool GA = true; // GA switch
     bool preTransformed = false;  // set flag for PreTransform()
+    int debug_level = 0; // 0 = no diagnostic files; >0 = also write normalized/shifted data and scaling parameters
 
 };
 
@@ -14,6 +14,7 @@
  * The structure includes:
  * - Simulation settings
  * - Data/model settings
+ * - Training (optimizer) settings
  * - GA & K-fold parameters
  * - Paths
  * - Architecture set selector
@@ -23,6 +24,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "modelcreator.h"
 #include "ffnwrapper_multi.h"
 
@@ -53,18 +55,35 @@ struct Config
     bool log_output_d;            ///< Whether to log-transform output.
 
     double Seed_number;           ///< Random seed for reproducibility.
+    int    n_threads;             ///< Worker threads for parallel candidate evaluation; also the OpenMP/BLAS thread count set once by main().
+    int    debug_level;           ///< 0 = no diagnostic dumps; >0 = write normalized/shifted data and scaling parameters.
+    bool   save_model;            ///< Write the trained network and its scaling to <outputpath>/model.ffnb.
 
     bool kfold;                   ///< Whether to use K-fold training.
     int  kfold_num;               ///< Number of folds.
     int  kfold_splitMode;         ///< 0=random, 1=expanding, 2=fixed.
+    bool kfold_parallel;          ///< Train the folds concurrently (one network and seed per fold).
 
     bool   GA_switch;             ///< true = GA optimization enabled.
     double GA_Nsim;               ///< Number of GA generations.
     bool   MSE_Test;              ///< GA objective uses only MSE-Test.
     bool   optimized_structure;   ///< Whether to use GA-optimized structure.
+    bool   GA_parallel;           ///< Train the candidates of each generation concurrently.
+    bool   GA_persist_cache;      ///< Keep the GA fitness cache in Results/GA_fitness_cache.txt across runs.
+    bool   GA_steady_state;       ///< Replace the worst individual as each offspring finishes instead of evolving whole generations.
+    bool   GA_checkpoint;         ///< Checkpoint the GA to Results/GA_checkpoint.bin every generation and resume from it.
+    bool   GA_successive_halving; ///< Screen new candidates with few epochs and fully train only the best (3 rungs, eta = 3).
+    bool   search_early_stopping; ///< Early stopping for GA/RMS/Bayesian candidates (overrides training.early_stopping there).
+
+    CTrainingConfig training;     ///< Optimizer, batch size, epochs, learning rate, tolerance, shuffle.
 
     bool   randommodelstructure;  ///< true = random model structures (RMS mode).
     double Random_Nsim;           ///< Number of random structures.
+    bool   Random_parallel;       ///< Train random structures concurrently on n_threads workers.
+    std::string Random_sampler;   ///< "uniform" = independent genes, "lhs" = Latin-hypercube design over the genes.
+
+    bool   bayesianoptimization;  ///< true = Bayesian (Gaussian-process) structure search.
+    double Bayesian_Nsim;         ///< Number of structures trained by the Bayesian search.
 
     /**
      * @brief Architecture set selector.
@@ -83,6 +102,12 @@ struct Config
     std::string datapath_ASM;     ///< Data path for ASM datasets.
 
     ModelCreator modelCreator;    ///< ModelCreator instance for GA/RMS.
+
+    std::string benchmark;        ///< Micro-benchmark to run instead of training ("" = none, "lag", "batch", "latency", "precision", "cache").
+
+    std::string score_model;                ///< Model bundle used for batch scoring.
+    std::vector<std::string> score_files;   ///< Files to score instead of training (empty = train normally).
+    std::string score_outputpath;           ///< Directory for the *_predicted.txt files.
 };
 
 /**
@@ -0,0 +1,184 @@
+/**
+ * @file datacache.cpp
+ * @brief Implements CDataTable and CDataCache (see datacache.h).
+ */
+
+#include "datacache.h"
+#include "cmodelstructure_multi.h"
+
+#include <BTCSet.h>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <thread>
+
+// ======================================================================
+//  Binary column file
+// ======================================================================
+
+namespace
+{
+    const char     BinaryMagic[8]  = {'F', 'F', 'N', 'C', 'O', 'L', '\0', '\0'};
+    const uint32_t BinaryVersion   = 1;
+
+    struct BinaryHeader
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t value_size;
+        uint64_t n_rows;
+        uint64_t n_cols;
+    };
+    static_assert(sizeof(BinaryHeader) == 32, "binary column header must stay 32 bytes");
+
+    // True if the binary copy exists and is at least as new as the text file
+    bool BinaryIsFresh(const std::string &address, const std::string &binary)
+    {
+        std::error_code ec;
+        const auto textTime = std::filesystem::last_write_time(address, ec);
+        if (ec)
+            return false;
+        const auto binaryTime = std::filesystem::last_write_time(binary, ec);
+        return !ec && binaryTime >= textTime;
+    }
+}
+
+// ======================================================================
+//  CDataTable
+// ======================================================================
+
+std::string CDataTable::BinaryPath(const std::string &address)
+{
+    return address + ".ffnc";
+}
+
+bool CDataTable::Load(const std::string &address, bool binaryCache)
+{
+    const std::string binary = BinaryPath(address);
+    if (binaryCache && BinaryIsFresh(address, binary) && LoadBinary(binary))
+        return !columns.is_empty();
+
+    try
+    {
+        CTimeSeriesSet<double> TimeSeries(address, true);
+
+        std::vector<int> allcolumns(TimeSeries.nvars);
+        std::iota(allcolumns.begin(), allcolumns.end(), 0);
+
+        // ToArmaMat() is variable-major (one row per variable); store time-major
+        columns = TimeSeries.ToArmaMat(allcolumns).t();
+
+        t.set_size(columns.n_rows);
+        for (arma::uword i = 0; i < columns.n_rows; i++)
+            t(i) = TimeSeries.BTC[0].GetT(i);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "[DataCache] Could not load " << address << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    if (binaryCache && !columns.is_empty())
+        SaveBinary(binary);
+
+    return !columns.is_empty();
+}
+
+bool CDataTable::LoadBinary(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    BinaryHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, BinaryMagic, sizeof(BinaryMagic)) != 0 ||
+        header.version != BinaryVersion ||
+        header.value_size != sizeof(double))
+        return false;
+
+    // Reject truncated files before allocating
+    std::error_code ec;
+    const uint64_t expected = sizeof(header) + header.n_rows * (header.n_cols + 1) * sizeof(double);
+    if (std::filesystem::file_size(filename, ec) != expected || ec)
+        return false;
+
+    arma::vec fileT(header.n_rows);
+    arma::mat fileColumns(header.n_rows, header.n_cols);
+    if (!file.read(reinterpret_cast<char *>(fileT.memptr()), fileT.n_elem * sizeof(double)) ||
+        !file.read(reinterpret_cast<char *>(fileColumns.memptr()), fileColumns.n_elem * sizeof(double)))
+        return false;
+
+    t.steal_mem(fileT);
+    columns.steal_mem(fileColumns);
+    return true;
+}
+
+bool CDataTable::SaveBinary(const std::string &filename) const
+{
+    BinaryHeader header;
+    std::memcpy(header.magic, BinaryMagic, sizeof(BinaryMagic));
+    header.version    = BinaryVersion;
+    header.value_size = sizeof(double);
+    header.n_rows     = columns.n_rows;
+    header.n_cols     = columns.n_cols;
+
+    // Write to a temporary name and rename, so a concurrent reader never sees a partial file.
+    // The name is unique per writer: two processes converting the same file must not share it.
+    std::random_device entropy;
+    std::ostringstream suffix;
+    suffix << ".tmp." << std::hex << entropy() << std::hash<std::thread::id>()(std::this_thread::get_id());
+    const std::string temporary = filename + suffix.str();
+    bool written = false;
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(t.memptr()), t.n_elem * sizeof(double));
+        file.write(reinterpret_cast<const char *>(columns.memptr()), columns.n_elem * sizeof(double));
+        file.close();
+        written = !file.fail();
+    }
+
+    std::error_code ec;
+    if (!written)
+    {
+        std::cerr << "[DataCache] Could not write " << temporary << std::endl;
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+
+    std::filesystem::rename(temporary, filename, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
+
+// ======================================================================
+//  CDataCache
+// ======================================================================
+
+bool CDataCache::Load(const CModelStructure_Multi &structure)
+{
+    train.assign(structure.trainaddress.size(), CDataTable());
+    test.assign(structure.testaddress.size(), CDataTable());
+
+    bool ok = true;
+    for (unsigned int i = 0; i < structure.trainaddress.size(); i++)
+        ok &= train[i].Load(structure.trainaddress[i]);
+    for (unsigned int i = 0; i < structure.testaddress.size(); i++)
+        ok &= test[i].Load(structure.testaddress[i]);
+
+    loaded = ok;
+    return ok;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file datacache.h
+ * @brief Declares CDataTable and CDataCache, the shared in-memory store of raw
+ *        (non-lagged) input data used by GA and random structure search.
+ *
+ * @details
+ * Without a cache every candidate evaluated by GA/RMS goes through
+ * FFNWrapper_Multi::Initiate() → DataProcess() → Shifter(), which re-parses
+ * the same observedoutput_train_*.txt / observedoutput_test_*.txt files into
+ * CTimeSeriesSet objects. With a CDataCache attached to
+ * @ref CModelStructure_Multi::DataCache, the files are parsed once per run and
+ * every candidate only gathers its own lagged design matrix from the cached
+ * columns.
+ *
+ * Only the raw columns are shared. Every candidate still fits its input
+ * scaling on its own lagged (trimmed, cleaned) matrix in Transformation(),
+ * exactly as without a cache, so a structure gets the same inputs — and the
+ * same fitness — whether it is searched or trained by RunSingle().
+ *
+ * The cache is immutable after Load() and is handed to candidates through a
+ * const pointer, so concurrent candidates can share it without locking.
+ *
+ * ### Binary column files
+ * Parsing the ASCII exports is the slow part of a load. CDataTable::Load()
+ * therefore keeps a binary copy of every text file next to it
+ * (<tt>&lt;file&gt;.ffnc</tt>) and reads that copy instead whenever it is newer
+ * than the text file. The layout is
+ *
+ * | Offset | Content                                              |
+ * |--------|------------------------------------------------------|
+ * | 0      | magic "FFNCOL\0\0" (8 bytes)                        |
+ * | 8      | uint32 format version, uint32 sizeof(double)         |
+ * | 16     | uint64 n_rows, uint64 n_cols                         |
+ * | 32     | n_rows doubles: time stamps                          |
+ * | ...    | n_rows × n_cols doubles: columns, column-major       |
+ *
+ * All sections are 8-byte aligned, so the file can be memory-mapped and the
+ * columns used in place; Load() reads them straight into the table storage.
+ * Deleting a .ffnc file is always safe, it is rebuilt on the next load.
+ *
+ * @see FFNWrapper_Multi::Shifter()
+ * @see FFNWrapper_Multi::Transformation()
+ */
+
+#pragma once
+
+#include <armadillo>
+#include <string>
+#include <vector>
+
+class CModelStructure_Multi;
+
+/**
+ * @struct CDataTable
+ * @brief Raw columns of one input file.
+ *
+ * @details
+ * Stored time-major: each column of @c columns is the contiguous series of one
+ * variable (file column), each row is one time step.
+ */
+struct CDataTable
+{
+    arma::vec t;          ///< Time stamps (one per row of @c columns).
+    arma::mat columns;    ///< n_time × n_variables.
+
+    /**
+     * @brief Load a time-series text file (with header) into this table.
+     *
+     * @details
+     * Reads <tt>address + ".ffnc"</tt> if it is newer than @p address;
+     * otherwise parses the text file and, if @p binaryCache is set, writes the
+     * binary copy for the next load.
+     *
+     * @param address     Path of the file, as in CModelStructure_Multi::trainaddress.
+     * @param binaryCache Use and maintain the binary column file.
+     * @return false if the file could not be read or is empty.
+     */
+    bool Load(const std::string &address, bool binaryCache = true);
+
+    /// Read a binary column file written by SaveBinary().
+    bool LoadBinary(const std::string &filename);
+
+    /// Write this table as a binary column file (atomically, via a temporary file).
+    bool SaveBinary(const std::string &filename) const;
+
+    /// Path of the binary column file kept for @p address.
+    static std::string BinaryPath(const std::string &address);
+};
+
+/**
+ * @class CDataCache
+ * @brief Raw train/test tables of a run, shared read-only by its candidates.
+ */
+class CDataCache
+{
+public:
+
+    /**
+     * @brief Load every train and test address of a model structure.
+     *
+     * @param structure Structure whose trainaddress/testaddress are loaded.
+     * @return true if all files were loaded.
+     */
+    bool Load(const CModelStructure_Multi &structure);
+
+    const std::vector<CDataTable> &Train() const { return train; }
+    const std::vector<CDataTable> &Test() const { return test; }
+
+    bool IsLoaded() const { return loaded; }
+
+private:
+    std::vector<CDataTable> train;
+    std::vector<CDataTable> test;
+    bool loaded = false;
+};
@@ -0,0 +1,93 @@
+/**
+ * @file earlystopping.h
+ * @brief Declares CEarlyStopping, an ensmallen callback that stops training
+ *        when a validation loss stops improving and remembers the best weights.
+ *
+ * @details
+ * ensmallen calls EndEpoch() after every pass over the training data. The
+ * callback evaluates the user-supplied validation loss on the current
+ * parameters and keeps a copy of the parameters with the lowest loss seen so
+ * far. Training is stopped once the loss has not improved by more than
+ * @c minDelta for @c patience consecutive epochs.
+ *
+ * ensmallen passes the coordinates as const, so the callback cannot roll the
+ * network back itself; the caller copies BestParameters() into the network
+ * after Train() returns.
+ *
+ * Usage:
+ * @code
+ * CEarlyStopping stop([&](const arma::mat&) { return ValidationLoss(); }, 3);
+ * FFN::Train(X, Y, optimizer, stop);
+ * if (stop.HasBest()) FFN::Parameters() = stop.BestParameters();
+ * @endcode
+ *
+ * @see FFNWrapper_Multi::Train()
+ * @see CTrainingConfig
+ */
+
+#pragma once
+
+#include <armadillo>
+#include <functional>
+#include <limits>
+
+class CEarlyStopping
+{
+public:
+
+    /**
+     * @param validationLoss Loss of the network at the given parameters (lower is better).
+     * @param patience       Epochs without improvement before stopping.
+     * @param minDelta       Smallest decrease that counts as an improvement.
+     */
+    CEarlyStopping(std::function<double(const arma::mat&)> validationLoss,
+                   size_t patience = 3,
+                   double minDelta = 0.0)
+        : validationLoss(std::move(validationLoss)),
+          patience(patience),
+          minDelta(minDelta)
+    {
+    }
+
+    /// Called by ensmallen at the end of every epoch; returning true stops the optimizer.
+    template<typename OptimizerType, typename FunctionType, typename MatType>
+    bool EndEpoch(OptimizerType& /* optimizer */,
+                  FunctionType& /* function */,
+                  const MatType& coordinates,
+                  const size_t epoch,
+                  const double /* objective */)
+    {
+        // Single-precision networks hand over arma::fmat coordinates
+        const arma::mat current = arma::conv_to<arma::mat>::from(coordinates);
+        const double loss = validationLoss(current);
+        epochs = epoch;
+
+        if (loss < bestLoss - minDelta)
+        {
+            bestLoss = loss;
+            bestEpoch = epoch;
+            bestParameters = current;
+            epochsWithoutImprovement = 0;
+            return false;
+        }
+
+        return ++epochsWithoutImprovement >= patience;
+    }
+
+    bool HasBest() const { return !bestParameters.is_empty(); }
+    const arma::mat& BestParameters() const { return bestParameters; }
+    double BestLoss() const { return bestLoss; }
+    size_t BestEpoch() const { return bestEpoch; }
+    size_t Epochs() const { return epochs; }     ///< Last epoch that was evaluated.
+
+private:
+    std::function<double(const arma::mat&)> validationLoss;
+    size_t patience;
+    double minDelta;
+
+    arma::mat bestParameters;
+    double bestLoss = std::numeric_limits<double>::infinity();
+    size_t bestEpoch = 0;
+    size_t epochs = 0;
+    size_t epochsWithoutImprovement = 0;
+};
@@ -15,8 +15,17 @@
 #include <fstream>
 #include <chrono>
 #include <cmath>
+#include <omp.h>
 #include <gnuplot-iostream.h>
 #include <CTransformation.h>
+#include "datacache.h"
+#include "lagembedding.h"
+#include "earlystopping.h"
+#include "metrics.h"
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
 
 // ────────── Namespaces ──────────
 using namespace mlpack;
@@ -34,6 +43,19 @@ inline QDebug operator<<(QDebug dbg, const arma::mat& m)
 }
 
 
+// Seeds the engines used for weight initialization and sample shuffling.
+// Inside an OpenMP parallel region only the calling thread's (thread_local)
+// Armadillo engine is seeded, so concurrently trained candidates neither
+// contend on nor reseed each other through mlpack's global RandomSeed().
+static void SeedRandomGenerators(double seed)
+{
+    if (omp_in_parallel())
+        arma::arma_rng::set_seed(static_cast<arma::arma_rng::seed_type>(seed));
+    else
+        mlpack::math::RandomSeed(seed);
+}
+
+
 FFNWrapper_Multi::FFNWrapper_Multi():FFN<MeanSquaredError>()
 {
 
@@ -46,6 +68,11 @@ FFNWrapper_Multi::FFNWrapper_Multi(const FFNWrapper_Multi &rhs):FFN<MeanSquaredE
     TrainOutputData = rhs.TrainOutputData;
     TestInputData = rhs.TestInputData;
     TestOutputData = rhs.TestOutputData;
+    PreTransformer = rhs.PreTransformer;
+    InputTransformer = rhs.InputTransformer;
+#if MLPACK_VERSION_MAJOR >= 4
+    FloatNetwork = rhs.FloatNetwork;
+#endif
 
 }
 
@@ -57,6 +84,11 @@ FFNWrapper_Multi& FFNWrapper_Multi::operator=(const FFNWrapper_Multi& rhs)
     TrainOutputData = rhs.TrainOutputData;
     TestInputData = rhs.TestInputData;
     TestOutputData = rhs.TestOutputData;
+    PreTransformer = rhs.PreTransformer;
+    InputTransformer = rhs.InputTransformer;
+#if MLPACK_VERSION_MAJOR >= 4
+    FloatNetwork = rhs.FloatNetwork;
+#endif
 
     return *this;
 }
@@ -82,7 +114,7 @@ bool FFNWrapper_Multi::Initiate(bool dataprocess)
         FFN<MeanSquaredError> newFFN;
         FFN<MeanSquaredError>::operator=(newFFN);
 
-        mlpack::math::RandomSeed(ModelStructure.seed_number);
+        SeedRandomGenerators(ModelStructure.seed_number);
         if(!ModelStructure.GA)
         {   qInfo() << "[Init] Network cleared and random seed set to"
                 << ModelStructure.seed_number;
@@ -95,13 +127,19 @@ bool FFNWrapper_Multi::Initiate(bool dataprocess)
         }
     }
 
+    return BuildNetwork(TrainInputData.n_rows, TrainOutputData.n_rows);
+}
+
+
+bool FFNWrapper_Multi::BuildNetwork(size_t inputDimension, size_t outputDimension)
+{
     // ───────────────────────────────────────────────
     // 3️⃣ Define architecture
     // ───────────────────────────────────────────────
         if(!ModelStructure.GA)
         {   qInfo() << "[Init] Building network architecture:";
-            qInfo() << "       Input dimension =" << TrainInputData.n_rows
-                << ", Output dimension =" << TrainOutputData.n_rows;
+            qInfo() << "       Input dimension =" << inputDimension
+                << ", Output dimension =" << outputDimension;
         }
 
     for (int layer = 0; layer < ModelStructure.n_layers; ++layer)
@@ -117,19 +155,42 @@ bool FFNWrapper_Multi::Initiate(bool dataprocess)
     }
 
     Add<ReLU>();
-    Add<Linear>(TrainOutputData.n_rows);
+    Add<Linear>(outputDimension);
 
         if(!ModelStructure.GA)
         {   qInfo().noquote() << QString("       Output: ReLU → Linear(%1)")
-                         .arg(TrainOutputData.n_rows);
+                         .arg(outputDimension);
+        }
+
+    // Single-precision twin with the same layers (and so the same parameter layout)
+#if MLPACK_VERSION_MAJOR >= 4
+    if (ModelStructure.training.single_precision)
+    {
+        FloatNetwork = FFN<MeanSquaredErrorType<arma::fmat>, RandomInitialization, arma::fmat>();
+        for (int layer = 0; layer < ModelStructure.n_layers; ++layer)
+        {
+            FloatNetwork.Add<LinearType<arma::fmat>>(ModelStructure.n_nodes[layer]);
+            FloatNetwork.Add<SigmoidType<arma::fmat>>();
         }
+        FloatNetwork.Add<ReLUType<arma::fmat>>();
+        FloatNetwork.Add<LinearType<arma::fmat>>(outputDimension);
+        FloatNetwork.InputDimensions() = { inputDimension };
+        FloatNetwork.Reset();
+
+        if(!ModelStructure.GA)
+            qInfo() << "[Init] Training in single precision (arma::fmat).";
+    }
+#else
+    if (ModelStructure.training.single_precision && !ModelStructure.GA)
+        qWarning() << "[Init] ⚠️ Single precision needs mlpack 4 — training in double.";
+#endif
 
     // ───────────────────────────────────────────────
     // 4️⃣ Initialize parameters (cross-version safe)
     // ───────────────────────────────────────────────
 #if MLPACK_VERSION_MAJOR >= 4
     // Explicitly define input size before reset (required in mlpack ≥4)
-    FFN::InputDimensions() = { TrainInputData.n_rows };
+    FFN::InputDimensions() = { inputDimension };
     FFN::Reset();
 #else
     FFN::ResetParameters();
@@ -176,11 +237,14 @@ bool FFNWrapper_Multi::PreTransform()
         // ───────────────────────────────────────────────
         // 1️⃣ Load raw (non-lagged) train/test data
         // ───────────────────────────────────────────────
-        CTimeSeriesSet<double> RawTrainTS(ModelStructure.trainaddress[0], true);
-        CTimeSeriesSet<double> RawTestTS(ModelStructure.testaddress[0], true);
+        CDataTable RawTrainTable, RawTestTable;
+        if (!RawTrainTable.Load(ModelStructure.trainaddress[0]) || !RawTestTable.Load(ModelStructure.testaddress[0]))
+            throw std::runtime_error("could not read raw train/test data");
 
-        arma::mat RawTrain = RawTrainTS.ToArmaMat(ModelStructure.inputcolumns);
-        arma::mat RawTest  = RawTestTS.ToArmaMat(ModelStructure.inputcolumns);
+        // Variable-major (one row per input variable), as ToArmaMat() returned
+        const arma::uvec inputs = arma::conv_to<arma::uvec>::from(ModelStructure.inputcolumns);
+        arma::mat RawTrain = RawTrainTable.columns.cols(inputs).t();
+        arma::mat RawTest  = RawTestTable.columns.cols(inputs).t();
 
         arma::mat All_DATA = arma::join_rows(RawTrain, RawTest);
 
@@ -191,6 +255,7 @@ bool FFNWrapper_Multi::PreTransform()
         // 2️⃣ Normalize entire dataset together
         // ───────────────────────────────────────────────
         CTransformation transformer;
+        transformer.verbose = !ModelStructure.GA;
         arma::mat normalizedData = transformer.normalize(All_DATA);
 
         // Save safe parameters (handle inf/NaN)
@@ -226,46 +291,40 @@ bool FFNWrapper_Multi::PreTransform()
         }
 
         // ───────────────────────────────────────────────
-        // 3️⃣ Split back into train/test and write as time-major matrices
+        // 3️⃣ Keep the fitted parameters for Shifter()
         // ───────────────────────────────────────────────
-        arma::uword trainCols = RawTrain.n_cols;
-        arma::uword testCols  = RawTest.n_cols;
+        PreTransformer.SetParameters(minVals, maxVals);
+        PreTransformer.verbose = !ModelStructure.GA;
+        ModelStructure.preTransformed = true;
 
-        arma::mat normTrain = normalizedData.cols(0, trainCols - 1);
-        arma::mat normTest  = normalizedData.cols(trainCols, trainCols + testCols - 1);
+        // ───────────────────────────────────────────────
+        // 4️⃣ Diagnostic dumps (debug_level > 0 only), time-major with a time column
+        // ───────────────────────────────────────────────
+        if (ModelStructure.debug_level > 0)
+        {
+            arma::uword trainCols = RawTrain.n_cols;
+            arma::uword testCols  = RawTest.n_cols;
 
-        // Time-major format (rows = timesteps, first column = time)
-        arma::vec t_train = arma::linspace(0, trainCols - 1, trainCols);
-        arma::mat train_with_time = arma::join_horiz(t_train, normTrain.t());
-        train_with_time.save(ModelStructure.outputpath + "normalized_raw_train.txt", arma::file_type::raw_ascii);
+            arma::mat normTrain = normalizedData.cols(0, trainCols - 1);
+            arma::mat normTest  = normalizedData.cols(trainCols, trainCols + testCols - 1);
 
-        arma::vec t_test = arma::linspace(trainCols, trainCols + testCols - 1, testCols);
-        arma::mat test_with_time = arma::join_horiz(t_test, normTest.t());
-        test_with_time.save(ModelStructure.outputpath + "normalized_raw_test.txt", arma::file_type::raw_ascii);
+            arma::vec t_train = arma::linspace(0, trainCols - 1, trainCols);
+            arma::mat train_with_time = arma::join_horiz(t_train, normTrain.t());
+            train_with_time.save(ModelStructure.outputpath + "normalized_raw_train.txt", arma::file_type::raw_ascii);
 
-        if (!ModelStructure.GA)
-        {
-            qInfo() << "[SaveData] Saved normalized train data →"
-                    << QString::fromStdString(ModelStructure.outputpath + "normalized_raw_train.txt");
-            qInfo() << "[SaveData] Saved normalized test data →"
-                    << QString::fromStdString(ModelStructure.outputpath + "normalized_raw_test.txt");
-        }
+            arma::vec t_test = arma::linspace(trainCols, trainCols + testCols - 1, testCols);
+            arma::mat test_with_time = arma::join_horiz(t_test, normTest.t());
+            test_with_time.save(ModelStructure.outputpath + "normalized_raw_test.txt", arma::file_type::raw_ascii);
 
-        // ───────────────────────────────────────────────
-        // 4️⃣ Save normalization parameters
-        // ───────────────────────────────────────────────
-        transformer.saveParameters(ModelStructure.outputpath + "scaling_params_raw.txt");
-        if (!ModelStructure.GA)
-            qInfo() << "[SaveParams] Saved normalization parameters →"
-                    << QString::fromStdString(ModelStructure.outputpath + "scaling_params_raw.txt");
+            PreTransformer.saveParameters(ModelStructure.outputpath + "scaling_params_raw.txt");
 
-        // ───────────────────────────────────────────────
-        // 5️⃣ Mark that pre-transform mode is active
-        // ───────────────────────────────────────────────
-        ModelStructure.preTransformed = true;
+            if (!ModelStructure.GA)
+                qInfo() << "[SaveData] Saved normalized raw data and scaling parameters →"
+                        << QString::fromStdString(ModelStructure.outputpath);
+        }
 
         if (!ModelStructure.GA)
-            qInfo() << "[PreTransform] ✅ Completed. Normalized raw data written.";
+            qInfo() << "[PreTransform] ✅ Completed.";
 
         return true;
     }
@@ -305,12 +364,9 @@ bool FFNWrapper_Multi::Shifter(datacategory DataCategory)
     }
 
     // ───────────────────────────────────────────────
-    // Determine maximum lag for trimming
+    // Determine maximum lag (first usable time step)
     // ───────────────────────────────────────────────
-    int maxLag = 0;
-    for (const auto& lagList : ModelStructure.lags)
-        if (!lagList.empty())
-            maxLag = std::max(maxLag, *std::max_element(lagList.begin(), lagList.end()));
+    const int maxLag = MaxLag(ModelStructure.lags);
 
     if (!ModelStructure.GA)
         qInfo() << "[Shifter] Maximum lag detected:" << maxLag;
@@ -318,24 +374,10 @@ bool FFNWrapper_Multi::Shifter(datacategory DataCategory)
     // ───────────────────────────────────────────────
     // Optional pre-transform (scaling)
     // ───────────────────────────────────────────────
-    CTransformation pretransformer;
-    bool usePreTransform = ModelStructure.preTransformed;
-
-    if (usePreTransform)
-    {
-        try {
-            std::string scaleFile = ModelStructure.outputpath + "scaling_params_raw.txt";
-            pretransformer.loadParameters(scaleFile);
-            if (!ModelStructure.GA)
-                qInfo() << "[Shifter] Using pre-transformed normalization (loaded from)"
-                        << QString::fromStdString(scaleFile);
-        }
-        catch (const std::exception& e) {
-            if (!ModelStructure.GA)
-            qWarning() << "[Shifter] ⚠️ Could not load pre-transform parameters:" << e.what();
-            usePreTransform = false;
-        }
-    }
+    // Parameters were fitted by PreTransform() and are kept in memory
+    const bool usePreTransform = ModelStructure.preTransformed;
+    if (usePreTransform && !ModelStructure.GA)
+        qInfo() << "[Shifter] Using pre-transformed normalization (fitted by PreTransform)";
 
     // ───────────────────────────────────────────────
     // Helper lambdas
@@ -347,13 +389,6 @@ bool FFNWrapper_Multi::Shifter(datacategory DataCategory)
         M.elem(arma::find_nonfinite(M)).fill(0.0);
     };
 
-    auto trim_by_maxlag = [this](arma::mat& X, arma::mat& Y, int lag) {
-        if (lag > 0 && X.n_cols > lag && Y.n_cols > lag) {
-            X = X.cols(lag, X.n_cols - 1);
-            Y = Y.cols(lag, Y.n_cols - 1);
-        }
-    };
-
     // ───────────────────────────────────────────────
     // Process each input file
     // ───────────────────────────────────────────────
@@ -366,34 +401,49 @@ bool FFNWrapper_Multi::Shifter(datacategory DataCategory)
 
         try
         {
-            CTimeSeriesSet<double> InputTimeSeries(addressList[i], true);
+            // Raw columns: shared cache (GA/RMS) or parsed here
+            CDataTable LocalTable;
+            const CDataTable* Table = &LocalTable;
 
-            arma::mat InputMatrix  = InputTimeSeries.ToArmaMatShifter(ModelStructure.inputcolumns, ModelStructure.lags);
-            arma::mat OutputMatrix = InputTimeSeries.ToArmaMatShifterOutput(ModelStructure.outputcolumns, ModelStructure.lags);
-
-            // Pre-transform if requested
-            if (usePreTransform)
+            if (ModelStructure.DataCache != nullptr)
             {
-                if (!ModelStructure.GA)
-                    qInfo() << "[Shifter] Applying pre-transform scaling to input matrix...";
-                InputMatrix = pretransformer.transform(InputMatrix);
+                const std::vector<CDataTable>& tables = (DataCategory == datacategory::Train)
+                    ? ModelStructure.DataCache->Train()
+                    : ModelStructure.DataCache->Test();
+
+                if (i >= tables.size())
+                    throw std::out_of_range("data cache holds no table for this address");
+
+                Table = &tables[i];
             }
+            else if (!LocalTable.Load(addressList[i]))
+                throw std::runtime_error("could not read " + addressList[i]);
+
+            // Lag embedding, already trimmed to samples t >= maxLag
+            arma::mat InputMatrix, OutputMatrix;
+            BuildLaggedMatrix(Table->columns, ModelStructure.inputcolumns, ModelStructure.lags, maxLag, InputMatrix);
+            BuildTargetMatrix(Table->columns, ModelStructure.outputcolumns, maxLag, OutputMatrix);
 
             // Log-transform outputs if requested
             if (ModelStructure.log_output)
             {
                 if (!ModelStructure.GA)
                     qInfo() << "[Shifter] Applying logarithmic transform to outputs...";
-                OutputMatrix = InputTimeSeries.Log().ToArmaMatShifterOutput(ModelStructure.outputcolumns, ModelStructure.lags);
+                OutputMatrix = arma::log(OutputMatrix);
+            }
+
+            // Pre-transform if requested
+            if (usePreTransform)
+            {
+                if (!ModelStructure.GA)
+                    qInfo() << "[Shifter] Applying pre-transform scaling to input matrix...";
+                InputMatrix = PreTransformer.transform(InputMatrix);
             }
 
             // Defensive cleaning
             sanitizeMatrix(InputMatrix, "InputMatrix");
             sanitizeMatrix(OutputMatrix, "OutputMatrix");
 
-            // Trim invalid lagged samples
-            trim_by_maxlag(InputMatrix, OutputMatrix, maxLag);
-
             // Log sizes
             if (!ModelStructure.GA) {
                 qInfo() << QString("  InputMatrix:  %1 × %2").arg(InputMatrix.n_rows).arg(InputMatrix.n_cols);
@@ -406,10 +456,11 @@ bool FFNWrapper_Multi::Shifter(datacategory DataCategory)
                 continue;
             }
 
-            // Append to cumulative matrices
+            // Append to cumulative matrices (the first segment is moved, not copied)
+            const arma::uword segmentSize = InputMatrix.n_cols;
             if (i == 0) {
-                InputDataRef  = InputMatrix;
-                OutputDataRef = OutputMatrix;
+                InputDataRef.steal_mem(InputMatrix);
+                OutputDataRef.steal_mem(OutputMatrix);
             } else {
                 if (InputDataRef.n_rows == InputMatrix.n_rows)
                     InputDataRef = arma::join_rows(InputDataRef, InputMatrix);
@@ -424,7 +475,7 @@ bool FFNWrapper_Multi::Shifter(datacategory DataCategory)
                     qWarning() << "[Shifter] ⚠️ Output row mismatch, skipping join for:" << filePath;
             }
 
-            segment_sizes.push_back(InputMatrix.n_cols);
+            segment_sizes.push_back(segmentSize);
             if (!ModelStructure.GA)
                 qInfo() << QString("  → Segment %1 added. Current total columns: %2")
                            .arg(i + 1).arg(InputDataRef.n_cols);
@@ -438,22 +489,25 @@ bool FFNWrapper_Multi::Shifter(datacategory DataCategory)
     }
 
     // ───────────────────────────────────────────────
-    // Export shifted data for inspection
+    // Export shifted data for inspection (debug_level > 0 only)
     // ───────────────────────────────────────────────
-    const std::string prefix = (DataCategory == datacategory::Train) ? "Train" : "Test";
-    try
+    if (ModelStructure.debug_level > 0)
     {
-        CTimeSeriesSet<double> ShiftedInputs(InputDataRef, ModelStructure.dt, ModelStructure.lags);
-        ShiftedInputs.writetofile(ModelStructure.outputpath + "ShiftedInputs" + prefix + ".txt");
+        const std::string prefix = (DataCategory == datacategory::Train) ? "Train" : "Test";
+        try
+        {
+            CTimeSeriesSet<double> ShiftedInputs(InputDataRef, ModelStructure.dt, ModelStructure.lags);
+            ShiftedInputs.writetofile(ModelStructure.outputpath + "ShiftedInputs" + prefix + ".txt");
 
-        CTimeSeriesSet<double> ShiftedOutputs =
-            CTimeSeriesSet<double>::OutputShifter(OutputDataRef, ModelStructure.dt, ModelStructure.lags);
-        ShiftedOutputs.writetofile(ModelStructure.outputpath + "ShiftedOutputs" + prefix + ".txt");
-    }
-    catch (const std::exception& e)
-    {
-        if (!ModelStructure.GA)
-        qWarning() << "[Shifter] ⚠️ Could not write shifted files:" << e.what();
+            CTimeSeriesSet<double> ShiftedOutputs =
+                CTimeSeriesSet<double>::OutputShifter(OutputDataRef, ModelStructure.dt, ModelStructure.lags);
+            ShiftedOutputs.writetofile(ModelStructure.outputpath + "ShiftedOutputs" + prefix + ".txt");
+        }
+        catch (const std::exception& e)
+        {
+            if (!ModelStructure.GA)
+            qWarning() << "[Shifter] ⚠️ Could not write shifted files:" << e.what();
+        }
     }
 
     // ───────────────────────────────────────────────
@@ -482,95 +536,52 @@ bool FFNWrapper_Multi::Transformation()
     if (!ModelStructure.GA)
         qInfo() << "\n[Transformation] Starting data normalization and parameter scaling...";
 
+    InputTransformer.verbose = !ModelStructure.GA;
+
     try
     {
         // ───────────────────────────────────────────────
-        // 1️⃣ Combine Train and Test for unified normalization
+        // 1️⃣ Fit once on Train + Test combined
         // ───────────────────────────────────────────────
         arma::mat All_DATA = arma::join_rows(TrainInputData, TestInputData);
 
         if (!ModelStructure.GA)
             qInfo() << "[Normalize] Input size:" << All_DATA.n_rows << "×" << All_DATA.n_cols;
 
-        CTransformation alldatatransformer;
-
         // Normalize all data
-        arma::mat normalizedData = alldatatransformer.normalize(All_DATA);
+        arma::mat normalizedData = InputTransformer.normalize(All_DATA);
 
         if (!ModelStructure.GA) {
             qInfo() << "[Normalize] Completed.";
-            arma::rowvec mins = alldatatransformer.GetMinValues().t();
-            arma::rowvec maxs = alldatatransformer.GetMaxValues().t();
+            arma::rowvec mins = InputTransformer.GetMinValues().t();
+            arma::rowvec maxs = InputTransformer.GetMaxValues().t();
             qInfo() << "  First 5 min values:" << mins.head(std::min((size_t)5, (size_t)mins.n_elem)).t();
             qInfo() << "  First 5 max values:" << maxs.head(std::min((size_t)5, (size_t)maxs.n_elem)).t();
         }
 
-        // Save normalized joined data
-        normalizedData.save(ModelStructure.outputpath + "normalizedidata.txt", arma::file_type::raw_ascii);
-        if (!ModelStructure.GA)
-            qInfo() << "[SaveData] Saved normalized joined data →"
-                    << QString::fromStdString(ModelStructure.outputpath + "normalizedidata.txt");
-
         // ───────────────────────────────────────────────
-        // 2️⃣ Save and reload scaling parameters
+        // 2️⃣ Apply the fitted parameters to Train and Test (in memory)
         // ───────────────────────────────────────────────
-        alldatatransformer.saveParameters(ModelStructure.outputpath + "scaling_params_all.txt");
-
-        if (!ModelStructure.GA)
-            qInfo() << "[SaveParams] Saved normalization parameters →"
-                    << QString::fromStdString(ModelStructure.outputpath + "scaling_params_all.txt");
-
-        // Reload parameters for both train and test
-        CTransformation traintransformer, testtransformer;
-        traintransformer.loadParameters(ModelStructure.outputpath + "scaling_params_all.txt");
-        testtransformer.loadParameters(ModelStructure.outputpath + "scaling_params_all.txt");
-
-        if (!ModelStructure.GA) {
-            qInfo() << "[LoadParams] Loaded scaling parameters for TRAIN and TEST ←"
-                    << QString::fromStdString(ModelStructure.outputpath + "scaling_params_all.txt");
-        }
+        TrainInputData = InputTransformer.transform(TrainInputData);
+        TestInputData  = InputTransformer.transform(TestInputData);
 
         // ───────────────────────────────────────────────
-        // 3️⃣ Apply normalization to Train and Test separately
+        // 3️⃣ Diagnostic dumps (debug_level > 0 only)
         // ───────────────────────────────────────────────
-        if (!ModelStructure.GA)
-            qInfo() << "[Transform] Applying stored normalization parameters to TRAIN data...";
-
-        arma::mat normalizedTrainData = traintransformer.transform(TrainInputData);
-
-        if (!ModelStructure.GA)
-            qInfo() << "[Transform] Done (TRAIN). Saving...";
-
-        normalizedTrainData.save(ModelStructure.outputpath + "normalizedtrainidata.txt",
-                                 arma::file_type::raw_ascii);
-
-        if (!ModelStructure.GA)
-            qInfo() << "[SaveData] Saved normalized train data →"
-                    << QString::fromStdString(ModelStructure.outputpath + "normalizedtrainidata.txt");
-
-        if (!ModelStructure.GA)
-            qInfo() << "[Transform] Applying stored normalization parameters to TEST data...";
-
-        arma::mat normalizedTestData = testtransformer.transform(TestInputData);
-
-        if (!ModelStructure.GA)
-            qInfo() << "[Transform] Done (TEST). Saving...";
-
-        normalizedTestData.save(ModelStructure.outputpath + "normalizedtestidata.txt",
-                                arma::file_type::raw_ascii);
-
-        if (!ModelStructure.GA)
-            qInfo() << "[SaveData] Saved normalized test data →"
-                    << QString::fromStdString(ModelStructure.outputpath + "normalizedtestidata.txt");
+        if (ModelStructure.debug_level > 0)
+        {
+            normalizedData.save(ModelStructure.outputpath + "normalizedidata.txt", arma::file_type::raw_ascii);
+            TrainInputData.save(ModelStructure.outputpath + "normalizedtrainidata.txt", arma::file_type::raw_ascii);
+            TestInputData.save(ModelStructure.outputpath + "normalizedtestidata.txt", arma::file_type::raw_ascii);
+            InputTransformer.saveParameters(ModelStructure.outputpath + "scaling_params_all.txt");
 
-        // ───────────────────────────────────────────────
-        // 4️⃣ Assign back normalized matrices
-        // ───────────────────────────────────────────────
-        TrainInputData = normalizedTrainData;
-        TestInputData  = normalizedTestData;
+            if (!ModelStructure.GA)
+                qInfo() << "[SaveData] Saved normalized data and scaling parameters →"
+                        << QString::fromStdString(ModelStructure.outputpath);
+        }
 
         // ───────────────────────────────────────────────
-        // 5️⃣ Summary statistics
+        // 4️⃣ Summary statistics
         // ───────────────────────────────────────────────
         if (!ModelStructure.GA) {
             qInfo() << "[Transformation] ✅ Completed successfully.";
@@ -595,7 +606,7 @@ bool FFNWrapper_Multi::Train()
 
     // Train the model
 
-    mlpack::math::RandomSeed(ModelStructure.seed_number);
+    SeedRandomGenerators(ModelStructure.seed_number);
     //SGD<> optimizer(/* stepSize = */ 0.01, /* batchSize = */ 32, /* maxIterations = */ 1000, /* tolerance = */ 1e-5, /* shuffle = */ false);
 /*
     qDebug() << "[Training] Input:" << TrainInputData.n_rows << "×" << TrainInputData.n_cols
@@ -610,40 +621,143 @@ bool FFNWrapper_Multi::Train()
     //PrintDataStats(TrainInputData, TrainOutputData, "Train (final normalized)");
 
 
-    ens::StandardSGD opt_SSGD(
-                0.1, // step size (learning rate)
-                1,  // batch size
-                10 * TrainInputData.n_cols, // max iterations (epochs × samples)
-                -100);
+    Fit(TrainInputData, TrainOutputData);
 
+    // Use the Predict method to get the predictions.
+    PredictNetwork(TrainInputData, TrainDataPrediction);
+    //cout << "Prediction:" << Prediction;
+
+    return true;
+}
 
-    ens::SGD opt_SGD(
-        0.001,     // step size (learning rate)
-        1,        // batch size
-        TrainInputData.n_cols * 10,  // max iterations (epochs × samples)
-        1e-6,      // tolerance
-        true       // shuffle
-    );
 
+// Runs the optimizer of @p training on any mlpack FFN. MatType is arma::mat for
+// the wrapper's own network and arma::fmat for the single-precision one.
+template<typename Network, typename MatType>
+static void FitNetwork(Network& network, const MatType& X, const MatType& Y,
+                       const CTrainingConfig& training, bool quiet)
+{
+    using eT = typename MatType::elem_type;
+
+    // Early stopping holds out the tail of the training window (time order is kept)
+    const arma::uword nSamples = X.n_cols;
+    arma::uword nValidation = 0;
+    if (training.early_stopping && nSamples >= 4)
+        nValidation = std::min<arma::uword>(nSamples / 2,
+                      std::max<arma::uword>(1, static_cast<arma::uword>(training.validation_fraction * nSamples)));
+    const arma::uword nFit = nSamples - nValidation;
+
+    // Optimizer from ModelStructure.training; ensmallen counts iterations in samples
+    const size_t batchSize     = std::max<size_t>(1, std::min<size_t>(training.batch_size, nFit));
+    const size_t maxIterations = training.epochs * nFit;
+
+    // Read-only alias of columns [first, first + count), as ColumnAlias()
+    auto alias = [](const MatType& M, arma::uword first, arma::uword count)
+    {
+        return MatType(const_cast<eT*>(M.colptr(0)) + first * M.n_rows, M.n_rows, count, false, true);
+    };
 
-    ens::Adam opt_Adam(
-        0.001,    // step size (learning rate)
-        1,       // batch size
-        0.9,      // beta1
-        0.999,    // beta2
-        1e-8,     // epsilon
-        TrainInputData.n_cols * 10,  // max iterations (epochs × samples)
-        1e-8,     // tolerance
-        true      // shuffle
-    );
+    auto fit = [&](auto& optimizer)
+    {
+        if (nValidation == 0)
+        {
+            network.Train(X, Y, optimizer);
+            return;
+        }
 
+        // Head and tail are contiguous column blocks: alias them instead of copying
+        const MatType FitInput   = alias(X, 0, nFit);
+        const MatType FitOutput  = alias(Y, 0, nFit);
+        const MatType ValInput   = alias(X, nFit, nValidation);
+        const MatType ValOutput  = alias(Y, nFit, nValidation);
 
-    FFN::Train(TrainInputData, TrainOutputData, opt_Adam);
+        // The optimizer updates the network parameters in place, so predicting here
+        // evaluates the coordinates of the epoch that just ended
+        CEarlyStopping stop([&](const arma::mat&)
+        {
+            MatType prediction;
+            network.Predict(ValInput, prediction);
+            return static_cast<double>(arma::accu(arma::square(prediction - ValOutput))) / ValOutput.n_elem;
+        }, training.patience, training.min_delta);
 
-    // Use the Predict method to get the predictions.
-    FFN::Predict(TrainInputData, TrainDataPrediction);
-    //cout << "Prediction:" << Prediction;
+        network.Train(FitInput, FitOutput, optimizer, stop);
 
+        if (stop.HasBest())
+            network.Parameters() = arma::conv_to<MatType>::from(stop.BestParameters());
+
+        if (!quiet)
+            qInfo() << "[Training] Early stopping: best validation MSE" << stop.BestLoss()
+                    << "at epoch" << stop.BestEpoch() << "of" << stop.Epochs();
+    };
+
+    if (training.optimizer == "SGD")
+    {
+        ens::SGD<> opt_SGD(training.learning_rate, batchSize, maxIterations,
+                           training.tolerance, training.shuffle);
+        fit(opt_SGD);
+    }
+    else if (training.optimizer == "RMSProp")
+    {
+        ens::RMSProp opt_RMSProp(training.learning_rate, batchSize, 0.99, 1e-8, maxIterations,
+                                 training.tolerance, training.shuffle);
+        fit(opt_RMSProp);
+    }
+    else
+    {
+        if (training.optimizer != "Adam" && !quiet)
+            qWarning() << "[Training] ⚠️ Unknown optimizer" << QString::fromStdString(training.optimizer)
+                       << "— using Adam.";
+
+        ens::Adam opt_Adam(
+            training.learning_rate, // step size (learning rate)
+            batchSize,              // batch size
+            0.9,                    // beta1
+            0.999,                  // beta2
+            1e-8,                   // epsilon
+            maxIterations,          // max iterations (epochs × samples)
+            training.tolerance,     // tolerance
+            training.shuffle        // shuffle
+        );
+        fit(opt_Adam);
+    }
+}
+
+
+bool FFNWrapper_Multi::Fit(const arma::mat& X, const arma::mat& Y)
+{
+    const CTrainingConfig& training = ModelStructure.training;
+
+#if MLPACK_VERSION_MAJOR >= 4
+    if (training.single_precision)
+    {
+        // Train in float, then copy the weights into the double network so
+        // FFN::Predict(), SaveModel() and CInferenceEngine see the trained model
+        const arma::fmat Xf = arma::conv_to<arma::fmat>::from(X);
+        const arma::fmat Yf = arma::conv_to<arma::fmat>::from(Y);
+        FitNetwork(FloatNetwork, Xf, Yf, training, ModelStructure.GA);
+        FFN::Parameters() = arma::conv_to<arma::mat>::from(FloatNetwork.Parameters());
+        return true;
+    }
+#endif
+
+    FitNetwork(static_cast<FFN<MeanSquaredError>&>(*this), X, Y, training, ModelStructure.GA);
+    return true;
+}
+
+
+bool FFNWrapper_Multi::PredictNetwork(const arma::mat& X, arma::mat& prediction)
+{
+#if MLPACK_VERSION_MAJOR >= 4
+    if (ModelStructure.training.single_precision)
+    {
+        arma::fmat predictionF;
+        FloatNetwork.Predict(arma::conv_to<arma::fmat>::from(X), predictionF);
+        prediction = arma::conv_to<arma::mat>::from(predictionF);
+        return true;
+    }
+#endif
+
+    FFN::Predict(X, prediction);
     return true;
 }
 
@@ -657,16 +771,32 @@ bool FFNWrapper_Multi::Train(const arma::mat& input, const arma::mat& output)
 }
 
 
+// MSE and R² of a prediction, as reported per fold
+static void FoldScores(const arma::mat& prediction, const arma::mat& target, double& mse, double& r2)
+{
+    mse = arma::mean(arma::mean(arma::square(prediction - target)));
+    arma::colvec meanTarget = arma::mean(target, 1);
+    double SSres = arma::accu(arma::square(prediction - target));
+    double SStot = arma::accu(arma::square(target.each_col() - meanTarget));
+    r2 = 1.0 - (SSres / (SStot + 1e-12));
+}
+
+
 // 0 = random K-fold, 1 = expanding window, 2 = fixed ratio (computed as 1 - 1/k)
-bool FFNWrapper_Multi::Train_kfold(int n_folds, int splitMode)
+bool FFNWrapper_Multi::Train_kfold(int n_folds, int splitMode, bool parallel)
 {
     if (n_folds < 2)
     {
         std::cerr << "Error: n_folds must be >= 2.\n";
         return false;
     }
+    if (splitMode < 0 || splitMode > 2)
+    {
+        std::cerr << "Invalid split mode.\n";
+        return false;
+    }
 
-    mlpack::math::RandomSeed(ModelStructure.seed_number);
+    SeedRandomGenerators(ModelStructure.seed_number);
 
     const size_t nSamples = TrainInputData.n_cols;
     if (nSamples < static_cast<size_t>(n_folds))
@@ -675,64 +805,90 @@ bool FFNWrapper_Multi::Train_kfold(int n_folds, int splitMode)
         return false;
     }
 
-    arma::mat X_full = TrainInputData;
-    arma::mat Y_full = TrainOutputData;
-
-    arma::mat X = TrainInputData;
-    arma::mat Y = TrainOutputData;
-
+    // Shuffle only for random K-fold (mode 0): a permutation, the data stay in place
+    // and each fold gathers its own columns through it
     arma::uvec indices;
-
-    // Shuffle only for random K-fold (mode 0)
     if (splitMode == 0)
     {
         indices = arma::randperm(nSamples);
-        X = X.cols(indices);
-        Y = Y.cols(indices);
         indices.save(ModelStructure.outputpath + "shuffle_indices.csv", arma::csv_ascii);
         std::cout << "[Info] Random shuffle applied and saved to shuffle_indices.csv\n";
     }
 
     const double trainRatio = 1.0 - (1.0 / static_cast<double>(n_folds));
 
-    std::vector<double> foldMSE, foldR2, foldTime;
-    std::vector<double> trainfoldMSE, trainfoldR2;
-    double totalMSE = 0.0, totalR2 = 0.0;
-    double traintotalMSE = 0.0, traintotalR2 = 0.0;
-
     std::cout << "Starting " << n_folds << "-fold cross-validation (mode " << splitMode
-              << ", train ratio ≈ " << trainRatio * 100 << "%)...\n";
+              << ", train ratio ≈ " << trainRatio * 100 << "%"
+              << (parallel ? ", folds in parallel" : "") << ")...\n";
 
+    // One slot per fold, filled by whichever thread trains it
+    struct FoldResult
+    {
+        bool   trained = false;
+        size_t nTrain = 0, nValidation = 0;
+        double trainMSE = 0, trainR2 = 0, valMSE = 0, valR2 = 0, seconds = 0;
+    };
+    std::vector<FoldResult> results(n_folds);
+
+    #pragma omp parallel for schedule(dynamic, 1) if(parallel && !omp_in_parallel())
     for (int fold = 0; fold < n_folds; ++fold)
     {
-        arma::mat trainX, trainY, valX, valY;
+        FoldResult& result = results[fold];
 
-        // ─────── Split selection ───────
-        if (splitMode == 0)
-        {
-            auto [trainPair, validPair] = KFoldSplit(X, Y, n_folds, fold);
-            trainX = trainPair.first;  trainY = trainPair.second;
-            valX   = validPair.first;  valY   = validPair.second;
-        }
-        else if (splitMode == 1)
-        {
-            auto [trainPair, validPair] = KFoldSplit_TimeSeries(X, Y, n_folds, fold);
-            trainX = trainPair.first;  trainY = trainPair.second;
-            valX   = validPair.first;  valY   = validPair.second;
-        }
-        else if (splitMode == 2)
-        {
-            auto [trainPair, validPair] = KFoldSplit_FixedRatio(X, Y, n_folds, fold, trainRatio);
-            trainX = trainPair.first;  trainY = trainPair.second;
-            valX   = validPair.first;  valY   = validPair.second;
-        }
-        else
+        const CFoldRanges split = KFoldRanges(nSamples, n_folds, fold, splitMode, trainRatio);
+        result.nTrain = split.TrainCount();
+        result.nValidation = split.validation.count;
+        if (result.nTrain < 2 || result.nValidation < 2)
+            continue;
+
+        // Contiguous ranges are aliased in place; only mode 0 gathers its (permuted) columns
+        auto columns = [&](const arma::mat& M, const std::vector<CColumnRange>& ranges) -> arma::mat
         {
-            std::cerr << "Invalid split mode.\n";
-            return false;
-        }
+            if (splitMode != 0 && ranges.size() == 1)
+                return ColumnAlias(M, ranges[0]);
+            return M.cols(RangeIndices(ranges, indices));
+        };
+        const arma::mat trainX = columns(TrainInputData, split.train);
+        const arma::mat trainY = columns(TrainOutputData, split.train);
+        const arma::mat valX   = columns(TrainInputData, {split.validation});
+        const arma::mat valY   = columns(TrainOutputData, {split.validation});
+
+        // Independent network with its own seed; the parent network is untouched
+        FFNWrapper_Multi foldModel;
+        foldModel.ModelStructure = ModelStructure;
+        foldModel.ModelStructure.GA = true;  // quiet: fold output is printed below, in fold order
+        foldModel.ModelStructure.seed_number = ModelStructure.seed_number + fold + 1;
+
+        SeedRandomGenerators(foldModel.ModelStructure.seed_number);
+        foldModel.BuildNetwork(trainX.n_rows, trainY.n_rows);
+
+        // ─────── Train this fold ───────
+        auto start = std::chrono::high_resolution_clock::now();
+        foldModel.Fit(trainX, trainY);
+        auto end = std::chrono::high_resolution_clock::now();
+        result.seconds = std::chrono::duration<double>(end - start).count();
+
+        // ─────── Evaluate ───────
+        arma::mat predTrain, predVal;
+        foldModel.FFN::Predict(trainX, predTrain);
+        FoldScores(predTrain, trainY, result.trainMSE, result.trainR2);
+
+        foldModel.FFN::Predict(valX, predVal);
+        FoldScores(predVal, valY, result.valMSE, result.valR2);
 
-        if (trainX.n_cols < 2 || valX.n_cols < 2)
+        result.trained = true;
+    }
+
+    // ─────── Report in fold order ───────
+    std::vector<double> foldMSE, foldR2, foldTime;
+    std::vector<double> trainfoldMSE, trainfoldR2;
+    double totalMSE = 0.0, totalR2 = 0.0;
+    double traintotalMSE = 0.0, traintotalR2 = 0.0;
+
+    for (int fold = 0; fold < n_folds; ++fold)
+    {
+        const FoldResult& result = results[fold];
+        if (!result.trained)
         {
             std::cout << "Skipping fold " << (fold + 1)
                       << " (too few samples)\n";
@@ -740,55 +896,25 @@ bool FFNWrapper_Multi::Train_kfold(int n_folds, int splitMode)
         }
 
         std::cout << "\nFold " << (fold + 1) << " / " << n_folds
-                  << " | Train samples: " << trainX.n_cols
-                  << " | Validation samples: " << valX.n_cols << std::endl;
-
-        // ⚠️ Reinitialize model to avoid cumulative training
-        FFN::operator=(FFN<MeanSquaredError>());
-        Initiate(false); // rebuild architecture with fresh random weights
-
-        // ─────── Train this fold ───────
-        auto start = std::chrono::high_resolution_clock::now();
-        this->Train(trainX, trainY);
-        auto end = std::chrono::high_resolution_clock::now();
-        double timeSec = std::chrono::duration<double>(end - start).count();
-
-        // ─────── Evaluate Training ───────
-        arma::mat predTrain;
-        this->Predict(trainX, predTrain);
-        double mseTrain = arma::mean(arma::mean(arma::square(predTrain - trainY)));
-        arma::rowvec meanYTrain = arma::mean(trainY, 1);
-        double SSresTrain = arma::accu(arma::square(predTrain - trainY));
-        double SStotTrain = arma::accu(arma::square(trainY.each_col() - meanYTrain));
-        double r2Train = 1.0 - (SSresTrain / (SStotTrain + 1e-12));
-
-        trainfoldMSE.push_back(mseTrain);
-        trainfoldR2.push_back(r2Train);
-        traintotalMSE += mseTrain;
-        traintotalR2  += r2Train;
-
-        std::cout << "  Training  MSE: " << std::setw(10) << mseTrain
-                  << " | R²: " << std::setw(8) << r2Train
-                  << " | Time: " << timeSec << " s" << std::endl;
-
-        // ─────── Evaluate Validation ───────
-        arma::mat predVal;
-        this->Predict(valX, predVal);
-        double mseVal = arma::mean(arma::mean(arma::square(predVal - valY)));
-        arma::rowvec meanYVal = arma::mean(valY, 1);
-        double SSresVal = arma::accu(arma::square(predVal - valY));
-        double SStotVal = arma::accu(arma::square(valY.each_col() - meanYVal));
-        double r2Val = 1.0 - (SSresVal / (SStotVal + 1e-12));
-
-        foldMSE.push_back(mseVal);
-        foldR2.push_back(r2Val);
-        foldTime.push_back(timeSec);
-        totalMSE += mseVal;
-        totalR2  += r2Val;
-
-        std::cout << "  Validation MSE: " << std::setw(10) << mseVal
-                  << " | R²: " << std::setw(8) << r2Val
-                  << " | Time: " << timeSec << " s" << std::endl;
+                  << " | Train samples: " << result.nTrain
+                  << " | Validation samples: " << result.nValidation << std::endl;
+        std::cout << "  Training  MSE: " << std::setw(10) << result.trainMSE
+                  << " | R²: " << std::setw(8) << result.trainR2
+                  << " | Time: " << result.seconds << " s" << std::endl;
+        std::cout << "  Validation MSE: " << std::setw(10) << result.valMSE
+                  << " | R²: " << std::setw(8) << result.valR2
+                  << " | Time: " << result.seconds << " s" << std::endl;
+
+        trainfoldMSE.push_back(result.trainMSE);
+        trainfoldR2.push_back(result.trainR2);
+        traintotalMSE += result.trainMSE;
+        traintotalR2  += result.trainR2;
+
+        foldMSE.push_back(result.valMSE);
+        foldR2.push_back(result.valR2);
+        foldTime.push_back(result.seconds);
+        totalMSE += result.valMSE;
+        totalR2  += result.valR2;
     }
 
     // ─────── Aggregate Results ───────
@@ -820,19 +946,16 @@ bool FFNWrapper_Multi::Train_kfold(int n_folds, int splitMode)
     // ─────── Final full retrain on entire dataset ───────
     std::cout << "Retraining final model on full dataset...\n";
     FFN::operator=(FFN<MeanSquaredError>()); // fresh start again
-    Initiate(false);
+    SeedRandomGenerators(ModelStructure.seed_number);
+    BuildNetwork(TrainInputData.n_rows, TrainOutputData.n_rows);
 
-    this->Train(X_full, Y_full);
+    this->Train();
 
-    arma::mat fullPred;
-    this->Predict(X_full, fullPred);
+    const arma::mat& fullPred = TrainDataPrediction;
     fullPred.save(ModelStructure.outputpath + "final_pred_full.csv", arma::csv_ascii);
 
-    double mse_final = arma::mean(arma::mean(arma::square(fullPred - Y_full)));
-    arma::rowvec meanY = arma::mean(Y_full, 1);
-    double SSres = arma::accu(arma::square(fullPred - Y_full));
-    double SStot = arma::accu(arma::square(Y_full.each_col() - meanY));
-    double r2_final = 1.0 - (SSres / (SStot + 1e-12));
+    double mse_final, r2_final;
+    FoldScores(fullPred, TrainOutputData, mse_final, r2_final);
 
     std::cout << "\nFinal full-data MSE: " << mse_final
               << " | R²: " << r2_final << std::endl;
@@ -848,6 +971,98 @@ bool FFNWrapper_Multi::Train_kfold(int n_folds, int splitMode)
 }
 
 
+CFoldRanges KFoldRanges(size_t n,
+                        size_t k,
+                        size_t fold,
+                        int splitMode,
+                        double trainRatio)
+{
+    if (k < 2 || fold >= k)
+        throw std::invalid_argument("KFoldRanges: invalid fold or k.");
+
+    const size_t foldSize = n / k;
+    const size_t valStart = fold * foldSize;
+    const size_t valEnd   = (fold == k - 1) ? n : (fold + 1) * foldSize;
+
+    CFoldRanges split;
+    split.validation = {valStart, valEnd - valStart};
+
+    if (splitMode == 0)
+    {
+        // Random K-fold: every other block trains
+        if (valStart > 0)
+            split.train.push_back({0, valStart});
+        if (valEnd < n)
+            split.train.push_back({valEnd, n - valEnd});
+        return split;
+    }
+
+    size_t trainEnd;
+    if (splitMode == 1)
+    {
+        // Expanding window: everything before the validation block
+        trainEnd = (valStart == 0) ? foldSize : valStart;
+        if (trainEnd < 2) trainEnd = 2;
+    }
+    else
+    {
+        // Fixed ratio: the same leading share of the data for every fold
+        if (trainRatio <= 0.0 || trainRatio >= 1.0)
+            throw std::invalid_argument("KFoldRanges: invalid trainRatio.");
+        trainEnd = static_cast<size_t>(trainRatio * n);
+    }
+
+    split.train.push_back({0, std::min(trainEnd, n)});
+    return split;
+}
+
+
+arma::uword CFoldRanges::TrainCount() const
+{
+    arma::uword count = 0;
+    for (const CColumnRange& range : train)
+        count += range.count;
+    return count;
+}
+
+
+arma::mat ColumnAlias(const arma::mat& M, const CColumnRange& range)
+{
+    if (range.first + range.count > M.n_cols)
+        throw std::out_of_range("ColumnAlias: range exceeds matrix columns.");
+
+    // Armadillo has no const aliasing constructor; the alias is only read
+    return arma::mat(const_cast<double*>(M.colptr(0)) + range.first * M.n_rows,
+                     M.n_rows, range.count, false, true);
+}
+
+
+arma::uvec RangeIndices(const std::vector<CColumnRange>& ranges, const arma::uvec& order)
+{
+    arma::uword count = 0;
+    for (const CColumnRange& range : ranges)
+        count += range.count;
+
+    arma::uvec indices(count);
+    arma::uword k = 0;
+    for (const CColumnRange& range : ranges)
+        for (arma::uword i = range.first; i < range.first + range.count; ++i)
+            indices(k++) = order.is_empty() ? i : order(i);
+    return indices;
+}
+
+
+// The copying KFoldSplit* helpers are kept for callers that want owned matrices
+
+static std::pair<std::pair<arma::mat, arma::mat>, std::pair<arma::mat, arma::mat>>
+CopyFold(const arma::mat& data, const arma::mat& labels, const CFoldRanges& split)
+{
+    const arma::uvec trainIdx = RangeIndices(split.train);
+    const arma::uvec valIdx   = RangeIndices({split.validation});
+    return {{data.cols(trainIdx), labels.cols(trainIdx)}, {data.cols(valIdx), labels.cols(valIdx)}};
+}
+
+
 std::pair<std::pair<arma::mat, arma::mat>,
           std::pair<arma::mat, arma::mat>>
 KFoldSplit(const arma::mat& data,
@@ -857,23 +1072,10 @@ KFoldSplit(const arma::mat& data,
 {
     if (k == 0 || fold >= k)
         throw std::invalid_argument("KFoldSplit: invalid fold or k.");
+    if (k == 1)
+        return {{arma::mat(data.n_rows, 0), arma::mat(labels.n_rows, 0)}, {data, labels}};
 
-    const size_t n = data.n_cols;
-    const size_t foldSize = n / k;
-    const size_t start = fold * foldSize;
-    const size_t end   = (fold == k - 1) ? n : start + foldSize;
-
-    arma::uvec valIdx  = arma::regspace<arma::uvec>(start, end - 1);
-    arma::uvec mask    = arma::ones<arma::uvec>(n);
-    mask(valIdx).zeros();
-    arma::uvec trainIdx = arma::find(mask == 1);
-
-    arma::mat trainData   = data.cols(trainIdx);
-    arma::mat trainLabels = labels.cols(trainIdx);
-    arma::mat validData   = data.cols(valIdx);
-    arma::mat validLabels = labels.cols(valIdx);
-
-    return {{trainData, trainLabels}, {validData, validLabels}};
+    return CopyFold(data, labels, KFoldRanges(data.n_cols, k, fold, 0, 0.0));
 }
 
 
@@ -887,20 +1089,7 @@ KFoldSplit_TimeSeries(const arma::mat& data,
    if (k < 2) throw std::invalid_argument("KFoldSplit_TimeSeries: k must be >= 2.");
    if (fold >= k) throw std::invalid_argument("KFoldSplit_TimeSeries: fold out of range.");
 
-   const size_t n = data.n_cols;
-   const size_t foldSize = n / k;
-   const size_t valStart = fold * foldSize;
-   const size_t valEnd   = (fold == k - 1) ? n : (fold + 1) * foldSize;
-
-   size_t trainEnd = (valStart == 0) ? foldSize : valStart;
-   if (trainEnd < 2) trainEnd = 2;
-
-   arma::mat trainData   = data.cols(0, trainEnd - 1);
-   arma::mat trainLabels = labels.cols(0, trainEnd - 1);
-   arma::mat validData   = data.cols(valStart, valEnd - 1);
-   arma::mat validLabels = labels.cols(valStart, valEnd - 1);
-
-   return {{trainData, trainLabels}, {validData, validLabels}};
+   return CopyFold(data, labels, KFoldRanges(data.n_cols, k, fold, 1, 0.0));
 }
 
 
@@ -917,18 +1106,7 @@ KFoldSplit_FixedRatio(const arma::mat& data,
   if (trainRatio <= 0.0 || trainRatio >= 1.0)
       throw std::invalid_argument("KFoldSplit_FixedRatio: invalid trainRatio.");
 
-  const size_t n = data.n_cols;
-  const size_t foldSize = n / k;
-  const size_t valStart = fold * foldSize;
-  const size_t valEnd   = (fold == k - 1) ? n : (fold + 1) * foldSize;
-  const size_t trainEnd = static_cast<size_t>(trainRatio * n);
-
-  arma::mat trainData   = data.cols(0, trainEnd - 1);
-  arma::mat trainLabels = labels.cols(0, trainEnd - 1);
-  arma::mat validData   = data.cols(valStart, valEnd - 1);
-  arma::mat validLabels = labels.cols(valStart, valEnd - 1);
-
-  return {{trainData, trainLabels}, {validData, validLabels}};
+  return CopyFold(data, labels, KFoldRanges(data.n_cols, k, fold, 2, trainRatio));
 }
 
 
@@ -936,7 +1114,7 @@ bool FFNWrapper_Multi::Test() // Predicting test data
 {
 
     // Use the Predict method to get the predictions.
-    FFN::Predict(TestInputData, TestDataPrediction);
+    PredictNetwork(TestInputData, TestDataPrediction);
     //cout << "Prediction:" << Prediction;
 
 
@@ -945,59 +1123,50 @@ bool FFNWrapper_Multi::Test() // Predicting test data
 
 bool FFNWrapper_Multi::PerformanceMetrics() // Calculating performance metrics
 {
-    segment_sizes.clear();
+    // Metrics straight from the matrices; time series are only built when files are written
+    Metrics_Train = ComputeMetrics(TrainDataPrediction, TrainOutputData);
+    Metrics_Test  = ComputeMetrics(TestDataPrediction, TestOutputData);
+
+    nMSE_Train.resize(ModelStructure.outputcolumns.size());
+    _R2_Train.resize(ModelStructure.outputcolumns.size());
+    nMSE_Test.resize(ModelStructure.outputcolumns.size());
+    _R2_Test.resize(ModelStructure.outputcolumns.size());
+    for (int constituent = 0; constituent<ModelStructure.outputcolumns.size(); constituent++)
+    {
+        nMSE_Train[constituent] = Metrics_Train[constituent].nMSE;
+        _R2_Train[constituent]  = Metrics_Train[constituent].R2;
+        nMSE_Test[constituent]  = Metrics_Test[constituent].nMSE;
+        _R2_Test[constituent]   = Metrics_Test[constituent].R2;
+    }
 
     // TrainData
-    CTimeSeriesSet<double> TrainDataPrediction1 (TrainDataPrediction,ModelStructure.dt,ModelStructure.lags);
+    segment_sizes.clear();
     segment_sizes.push_back(TrainDataPrediction.n_cols);
-    vector<CTimeSeriesSet<double>> TrainDataPredictionSplit = CTimeSeriesSet<double>::GetFromArmaMatandSplit(TrainDataPrediction,ModelStructure.dt,ModelStructure.lags,segment_sizes);
     if (!silent)
+    {
+        vector<CTimeSeriesSet<double>> TrainDataPredictionSplit = CTimeSeriesSet<double>::GetFromArmaMatandSplit(TrainDataPrediction,ModelStructure.dt,ModelStructure.lags,segment_sizes);
         for (unsigned int i=0; i<TrainDataPredictionSplit.size(); i++)
             TrainDataPredictionSplit[i].writetofile(ModelStructure.outputpath + "TrainDataPrediction_" + to_string(i) + ".txt");
-    CTimeSeriesSet<double> TrainDataTarget = GetTrainOutputData();
 
-    vector<CTimeSeriesSet<double>> TrainDataTargetSplit = CTimeSeriesSet<double>::GetFromArmaMatandSplit(TrainOutputData,ModelStructure.dt,ModelStructure.lags,segment_sizes);
-    if (!silent)
+        vector<CTimeSeriesSet<double>> TrainDataTargetSplit = CTimeSeriesSet<double>::GetFromArmaMatandSplit(TrainOutputData,ModelStructure.dt,ModelStructure.lags,segment_sizes);
         for (unsigned int i=0; i<TrainDataTargetSplit.size(); i++)
             TrainDataTargetSplit[i].writetofile(ModelStructure.outputpath + "TrainDataTarget_" + to_string(i) + ".txt");
-
-    nMSE_Train.resize(ModelStructure.outputcolumns.size());
-    _R2_Train.resize(ModelStructure.outputcolumns.size());
-    for (int constituent = 0; constituent<ModelStructure.outputcolumns.size(); constituent++)
-    {
-        double MSE = diff2(TrainDataPrediction1.BTC[constituent],TrainDataTarget.BTC[constituent]);
-        double VAR = TrainDataTarget.BTC[constituent].variance();
-
-        nMSE_Train[constituent] = MSE/VAR;
-        _R2_Train[constituent] = R2(TrainDataPrediction1.BTC[constituent],TrainDataTarget.BTC[constituent]);
     }
 
-    segment_sizes.clear();
-
     // TestData
-    CTimeSeriesSet<double> TestDataPrediction1 (TestDataPrediction,ModelStructure.dt,ModelStructure.lags);
+    segment_sizes.clear();
     segment_sizes.push_back(TestDataPrediction.n_cols);
-    vector<CTimeSeriesSet<double>> TestDataPredictionSplit = CTimeSeriesSet<double>::GetFromArmaMatandSplit(TestDataPrediction,ModelStructure.dt,ModelStructure.lags,segment_sizes);
     if (!silent)
+    {
+        vector<CTimeSeriesSet<double>> TestDataPredictionSplit = CTimeSeriesSet<double>::GetFromArmaMatandSplit(TestDataPrediction,ModelStructure.dt,ModelStructure.lags,segment_sizes);
         for (unsigned int i=0; i<TestDataPredictionSplit.size(); i++)
             TestDataPredictionSplit[i].writetofile(ModelStructure.outputpath + "TestDataPrediction_" + to_string(i) + ".txt");
-    CTimeSeriesSet<double> TestDataTarget = GetTestOutputData();
 
-    vector<CTimeSeriesSet<double>> TestDataTargetSplit = CTimeSeriesSet<double>::GetFromArmaMatandSplit(TestOutputData,ModelStructure.dt,ModelStructure.lags,segment_sizes);
-    if (!silent)
+        vector<CTimeSeriesSet<double>> TestDataTargetSplit = CTimeSeriesSet<double>::GetFromArmaMatandSplit(TestOutputData,ModelStructure.dt,ModelStructure.lags,segment_sizes);
         for (unsigned int i=0; i<TestDataTargetSplit.size(); i++)
-
             TestDataTargetSplit[i].writetofile(ModelStructure.outputpath + "TestDataTarget_" + to_string(i) + ".txt");
-    nMSE_Test.resize(ModelStructure.outputcolumns.size());
-    _R2_Test.resize(ModelStructure.outputcolumns.size());
-    for (int constituent = 0; constituent<ModelStructure.outputcolumns.size(); constituent++)
-    {
-        double MSE = diff2(TestDataPrediction1.BTC[constituent],TestDataTarget.BTC[constituent]);
-        double VAR = TestDataTarget.BTC[constituent].variance();
-
-        nMSE_Test[constituent] = MSE/VAR;
-        _R2_Test[constituent] = R2(TestDataPrediction1.BTC[constituent],TestDataTarget.BTC[constituent]);
     }
+
     return true;
 }
 
@@ -1080,6 +1249,104 @@ bool FFNWrapper_Multi::DataSave(datacategory DataCategory) // Saving data
 }
 
 
+// ────────── Model bundle ──────────
+// One cereal binary archive: format tag, structure definition, input scalers, network.
+
+static const std::string ModelBundleTag = "FFN_Wrapper model bundle";
+static const uint32_t    ModelBundleVersion = 1;
+
+template<class Archive>
+static void SerializeBundleStructure(Archive& ar, CModelStructure_Multi& ms)
+{
+    ar(ms.dt, ms.n_layers, ms.n_nodes, ms.node_type, ms.activation_function,
+       ms.inputcolumns, ms.outputcolumns, ms.lags, ms.input_lag_multiplier,
+       ms.log_output, ms.preTransformed, ms.seed_number);
+}
+
+template<class Archive>
+static void SerializeBundleTransformer(Archive& ar, CTransformation& transformer)
+{
+    std::vector<double> minValues = arma::conv_to<std::vector<double>>::from(transformer.GetMinValues());
+    std::vector<double> maxValues = arma::conv_to<std::vector<double>>::from(transformer.GetMaxValues());
+    ar(minValues, maxValues);
+    transformer.SetParameters(arma::colvec(minValues), arma::colvec(maxValues));
+}
+
+bool FFNWrapper_Multi::SaveModel(const std::string& filename)
+{
+    try
+    {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open())
+            throw std::runtime_error("unable to open " + filename);
+
+        cereal::BinaryOutputArchive ar(file);
+        std::string tag = ModelBundleTag;
+        uint32_t version = ModelBundleVersion;
+        ar(tag, version);
+        SerializeBundleStructure(ar, ModelStructure);
+        SerializeBundleTransformer(ar, PreTransformer);
+        SerializeBundleTransformer(ar, InputTransformer);
+        ar(cereal::make_nvp("network", static_cast<FFN<MeanSquaredError>&>(*this)));
+    }
+    catch (const std::exception& e)
+    {
+        qCritical() << "[SaveModel] ❌ Could not write model bundle:" << e.what();
+        return false;
+    }
+
+    if (!ModelStructure.GA)
+        qInfo() << "[SaveModel] Model bundle written →" << QString::fromStdString(filename);
+    return true;
+}
+
+bool FFNWrapper_Multi::LoadModel(const std::string& filename)
+{
+    try
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open())
+            throw std::runtime_error("unable to open " + filename);
+
+        cereal::BinaryInputArchive ar(file);
+        std::string tag;
+        uint32_t version = 0;
+        ar(tag, version);
+        if (tag != ModelBundleTag || version != ModelBundleVersion)
+            throw std::runtime_error("not a model bundle of this version");
+
+        SerializeBundleStructure(ar, ModelStructure);
+        SerializeBundleTransformer(ar, PreTransformer);
+        SerializeBundleTransformer(ar, InputTransformer);
+        ar(cereal::make_nvp("network", static_cast<FFN<MeanSquaredError>&>(*this)));
+    }
+    catch (const std::exception& e)
+    {
+        qCritical() << "[LoadModel] ❌ Could not read model bundle:" << e.what();
+        return false;
+    }
+
+    // A loaded bundle only predicts: keep its scalers quiet
+    PreTransformer.verbose = InputTransformer.verbose = false;
+
+    if (!ModelStructure.GA)
+        qInfo() << "[LoadModel] Model bundle loaded ←" << QString::fromStdString(filename);
+    return true;
+}
+
+bool FFNWrapper_Multi::Forecast(const arma::mat& laggedInputs, arma::mat& prediction)
+{
+    arma::mat input = ModelStructure.preTransformed ? PreTransformer.transform(laggedInputs) : laggedInputs;
+    input = InputTransformer.transform(input);
+
+    FFN::Predict(input, prediction);
+
+    if (ModelStructure.log_output)
+        prediction = arma::exp(prediction);
+    return true;
+}
+
+
 bool FFNWrapper_Multi:: Plotter() // Plotting the results
 {
 
@@ -5,6 +5,8 @@
 #include <vector>
 #include <BTCSet.h>
 #include "cmodelstructure_multi.h"
+#include <CTransformation.h>
+#include "metrics.h"
 #include <gnuplot-iostream.h>
 
 using namespace mlpack;
@@ -22,20 +24,33 @@ public:
     virtual ~FFNWrapper_Multi();
 
     bool Initiate(bool dataprocess = true);
+    bool BuildNetwork(size_t inputDimension, size_t outputDimension); // adds the layers of ModelStructure to an empty network and initializes the weights
     bool DataProcess();
     bool PreTransform();
     bool Shifter(datacategory);
     bool Transformation();
     bool Train();
     bool Train(const arma::mat& input, const arma::mat& output);
+    bool Fit(const arma::mat& X, const arma::mat& Y); // runs the configured optimizer on X/Y without copying them into TrainInputData
     //bool Train_Single(bool shuffle = true);
-    bool Train_kfold(int n_folds, int splitMode);
+    bool Train_kfold(int n_folds, int splitMode, bool parallel = true);
     bool Test();
     bool PerformanceMetrics();
     bool DataSave(datacategory);
     bool Plotter();
     bool PrintDataStats(const arma::mat& X, const arma::mat& Y, const std::string& tag);
     bool Optimizer();
+
+    // Model bundle: network weights, structure definition and input scalers in one binary file
+    bool SaveModel(const std::string& filename);
+    bool LoadModel(const std::string& filename);
+    bool Forecast(const arma::mat& laggedInputs, arma::mat& prediction); // raw lagged inputs (as from Shifter) → outputs
+    const arma::mat& NetworkParameters() const { return FFN::Parameters(); } // flat weights, layer by layer (read by CInferenceEngine)
+    const CTransformation& GetPreTransformer() const { return PreTransformer; }
+    const CTransformation& GetInputTransformer() const { return InputTransformer; }
+    const arma::mat& TrainInputs() const { return TrainInputData; } // scaled lagged inputs, as fed to the network
+    const arma::mat& TestInputs() const { return TestInputData; }
+
     mat A;
     vector<int> segment_sizes;
     CModelStructure_Multi ModelStructure;
@@ -68,6 +83,8 @@ public:
     vector<double> _R2_Train;
     vector<double> nMSE_Test;
     vector<double> _R2_Test;
+    vector<CMetrics> Metrics_Train; // all measures per output (nMSE, R2, NSE, KGE, MAE, MSE)
+    vector<CMetrics> Metrics_Test;
 
     //Normalization
     mlpack::data::MinMaxScaler minMaxScaler_tr_i;
@@ -81,6 +98,12 @@ private:
     mat TrainOutputData;
     mat TestInputData;
     mat TestOutputData;
+    CTransformation PreTransformer; // raw-data scaling fitted by PreTransform(), applied in Shifter()
+    CTransformation InputTransformer; // scaling of the lagged inputs fitted (or set from the data cache) in Transformation()
+#if MLPACK_VERSION_MAJOR >= 4
+    FFN<MeanSquaredErrorType<arma::fmat>, RandomInitialization, arma::fmat> FloatNetwork; // trained instead of the double network when training.single_precision is set
+#endif
+    bool PredictNetwork(const arma::mat& X, arma::mat& prediction); // FFN::Predict, or the float network in single precision
 
 
 };
@@ -150,4 +173,66 @@ std::pair<std::pair<arma::mat, arma::mat>, std::pair<arma::mat, arma::mat>> KFol
            size_t k,
            size_t fold);
 
+/**
+ * @brief Contiguous block of columns [first, first + count).
+ */
+struct CColumnRange
+{
+    arma::uword first = 0;
+    arma::uword count = 0;
+};
+
+/**
+ * @brief Training and validation columns of one fold, as ranges.
+ *
+ * @details
+ * For split modes 1 and 2 the ranges index the data directly and the training
+ * set is a single range, so both sets can be aliased with ColumnAlias()
+ * without copying. For mode 0 the ranges index a permutation of the samples
+ * (see RangeIndices()).
+ */
+struct CFoldRanges
+{
+    std::vector<CColumnRange> train;   ///< One range, or two around the validation block (mode 0).
+    CColumnRange validation;
+
+    arma::uword TrainCount() const;
+};
+
+/**
+ * @brief Split of one fold as column ranges.
+ *
+ * @details
+ * Same splits as KFoldSplit() (mode 0), KFoldSplit_TimeSeries() (mode 1) and
+ * KFoldSplit_FixedRatio() (mode 2), without touching any data.
+ *
+ * @param n          Number of samples.
+ * @param k          Number of folds (>= 2).
+ * @param fold       Validation fold, in [0, k-1].
+ * @param splitMode  0 = random (ranges of the permuted order), 1 = expanding window, 2 = fixed ratio.
+ * @param trainRatio Leading share used for training in mode 2.
+ *
+ * @throws std::invalid_argument on an invalid fold, k or trainRatio.
+ */
+CFoldRanges KFoldRanges(size_t n,
+                        size_t k,
+                        size_t fold,
+                        int splitMode,
+                        double trainRatio);
+
+/**
+ * @brief Non-owning, read-only view of a column range of @p M as an arma::mat.
+ *
+ * @details
+ * Unlike a subview, the result can be passed wherever a <tt>const arma::mat&</tt>
+ * is expected (mlpack Train()/Predict()). It shares the memory of @p M, so it
+ * must not outlive @p M, and @p M must not be resized while it is in use.
+ */
+arma::mat ColumnAlias(const arma::mat& M, const CColumnRange& range);
+
+/**
+ * @brief Column indices covered by @p ranges, mapped through @p order if not empty.
+ */
+arma::uvec RangeIndices(const std::vector<CColumnRange>& ranges, const arma::uvec& order = arma::uvec());
+
 #endif // FFNWrapper_MULTI_H
@@ -0,0 +1,202 @@
+/**
+ * @file fitnesscache.cpp
+ * @brief Implements CFitnessCache (see fitnesscache.h).
+ */
+
+#include "fitnesscache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+const std::string CFitnessCache::DataHeader = "#data";
+
+// ======================================================================
+//  Canonical key
+// ======================================================================
+
+std::string CFitnessCache::Key(const CModelStructure_Multi &structure)
+{
+    std::ostringstream key;
+
+    key << "c:";
+    for (unsigned int i = 0; i < structure.inputcolumns.size(); i++)
+        key << (i ? "," : "") << structure.inputcolumns[i];
+
+    key << "|m:" << structure.input_lag_multiplier;
+
+    key << "|l:";
+    for (unsigned int i = 0; i < structure.lags.size(); i++)
+    {
+        if (i) key << ";";
+        for (unsigned int j = 0; j < structure.lags[i].size(); j++)
+            key << (j ? "," : "") << structure.lags[i][j];
+    }
+
+    key << "|n:";
+    for (unsigned int i = 0; i < structure.n_nodes.size(); i++)
+        key << (i ? "," : "") << structure.n_nodes[i];
+
+    key << "|o:";
+    for (unsigned int i = 0; i < structure.outputcolumns.size(); i++)
+        key << (i ? "," : "") << structure.outputcolumns[i];
+    key << "|log:" << structure.log_output << "|pre:" << structure.preTransformed;
+
+    key << "|s:" << std::setprecision(17) << structure.seed_number << "|dt:" << structure.dt;
+
+    const CTrainingConfig &training = structure.training;
+    key << "|t:" << training.optimizer << "," << training.batch_size << "," << training.epochs
+        << "," << training.learning_rate << "," << training.tolerance << "," << training.shuffle;
+    if (training.early_stopping)
+        key << ",es:" << training.validation_fraction << "," << training.patience << "," << training.min_delta;
+    if (training.single_precision)
+        key << ",f32";
+
+    return key.str();
+}
+
+uint64_t CFitnessCache::Hash(const std::string &key)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : key)
+    {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string CFitnessCache::DataFingerprint(const CModelStructure_Multi &structure)
+{
+    std::ostringstream fingerprint;
+    for (const std::vector<std::string> *addresses : {&structure.trainaddress, &structure.testaddress})
+    {
+        for (const std::string &address : *addresses)
+        {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(address, ec);
+            fingerprint << address << ":" << (ec ? 0 : size);
+            const auto modified = std::filesystem::last_write_time(address, ec);
+            fingerprint << ":" << (ec ? 0 : modified.time_since_epoch().count()) << ";";
+        }
+        fingerprint << "|";
+    }
+    return fingerprint.str();
+}
+
+// ======================================================================
+//  Lookup / Store
+// ======================================================================
+
+bool CFitnessCache::Lookup(const CModelStructure_Multi &structure, std::map<std::string, double> &fitness_measures)
+{
+    const std::string key = Key(structure);
+    auto it = entries.find(Hash(key));
+
+    if (it == entries.end() || it->second.key != key)
+    {
+        misses++;
+        return false;
+    }
+
+    fitness_measures = it->second.fitness_measures;
+    hits++;
+    return true;
+}
+
+void CFitnessCache::Store(const CModelStructure_Multi &structure, const std::map<std::string, double> &fitness_measures)
+{
+    Store(Key(structure), fitness_measures);
+}
+
+void CFitnessCache::Store(const std::string &key, const std::map<std::string, double> &fitness_measures)
+{
+    Entry &entry = entries[Hash(key)];
+    entry.key = key;
+    entry.fitness_measures = fitness_measures;
+}
+
+void CFitnessCache::clear()
+{
+    entries.clear();
+    hits = 0;
+    misses = 0;
+}
+
+// ======================================================================
+//  Persistence
+// ======================================================================
+
+bool CFitnessCache::Save(std::ostream &out) const
+{
+    out << std::setprecision(17);
+    if (!dataFingerprint.empty())
+        out << DataHeader << "\t" << dataFingerprint << "\n";
+    for (const auto &item : entries)
+    {
+        out << item.second.key << "\t";
+        for (const auto &measure : item.second.fitness_measures)
+            out << measure.first << "=" << measure.second << ";";
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool CFitnessCache::Save(const std::string &filename) const
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+    {
+        std::cerr << "[FitnessCache] Unable to open file for writing: " << filename << std::endl;
+        return false;
+    }
+    return Save(file);
+}
+
+bool CFitnessCache::Load(std::istream &in)
+{
+    std::string line;
+
+    // Entries measured on other data (or of unknown data) are stale
+    if (!dataFingerprint.empty())
+    {
+        const std::string expected = DataHeader + "\t" + dataFingerprint;
+        if (!std::getline(in, line) || line != expected)
+            return false;
+    }
+
+    while (std::getline(in, line))
+    {
+        const size_t tab = line.find('\t');
+        if (tab == std::string::npos || line.compare(0, DataHeader.size(), DataHeader) == 0)
+            continue;
+
+        std::map<std::string, double> fitness_measures;
+        std::stringstream measures(line.substr(tab + 1));
+        std::string item;
+        while (std::getline(measures, item, ';'))
+        {
+            const size_t eq = item.find('=');
+            if (eq == std::string::npos)
+                continue;
+            fitness_measures[item.substr(0, eq)] = std::stod(item.substr(eq + 1));
+        }
+
+        Store(line.substr(0, tab), fitness_measures);
+    }
+    return true;
+}
+
+bool CFitnessCache::Load(const std::string &filename)
+{
+    std::ifstream file(filename);
+    if (!file.is_open())
+        return false;
+    if (!Load(file))
+    {
+        std::cerr << "[FitnessCache] " << filename << " was computed on other train/test data; ignoring it" << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file fitnesscache.h
+ * @brief Declares CFitnessCache, a memoization table for GA fitness measures.
+ *
+ * @details
+ * The GA frequently re-creates chromosomes it has already trained (the elite is
+ * carried forward, mutation often leaves a chromosome untouched, and several
+ * chromosomes decode to the same network because genes of unselected columns
+ * are ignored). CFitnessCache maps the *decoded* model structure to the
+ * fitness measures returned by ModelCreator::Fitness(), so identical
+ * structures are trained only once.
+ *
+ * The key is a canonical text form of:
+ * - inputcolumns
+ * - lags
+ * - n_nodes
+ * - input_lag_multiplier
+ * - outputcolumns, log_output, preTransformed
+ * - seed_number, dt
+ * - the training configuration (optimizer, batch size, epochs, learning rate,
+ *   tolerance, shuffle and, when enabled, the early-stopping settings)
+ *
+ * Entries are stored under the 64-bit FNV-1a hash of that text; the text itself
+ * is kept alongside to rule out hash collisions.
+ *
+ * The cache can be saved to / loaded from a plain-text file so that restarted
+ * GA runs start warm. With a data fingerprint set (train/test paths, sizes and
+ * modification times), the file starts with a "#data" line and a file written
+ * for other data is ignored as a whole.
+ *
+ * @see GeneticAlgorithm::AssignFitnesses()
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include "cmodelstructure_multi.h"
+
+/**
+ * @class CFitnessCache
+ * @brief Stores fitness measures per decoded CModelStructure_Multi.
+ *
+ * @note Not internally synchronized. The GA performs all lookups and stores
+ *       outside of its parallel training region.
+ */
+class CFitnessCache
+{
+public:
+
+    /**
+     * @brief Canonical key of a model structure.
+     *
+     * @return e.g. "c:0,1,6|m:3|l:0,3;6;0,9|n:10,28|s:42|t:Adam,32,10,..."
+     */
+    static std::string Key(const CModelStructure_Multi &structure);
+
+    /** @brief Paths, sizes and modification times of the train/test files of @p structure. */
+    static std::string DataFingerprint(const CModelStructure_Multi &structure);
+
+    /** @brief Data the entries are measured on; Save() records it and Load() requires it. */
+    void SetDataFingerprint(const std::string &fingerprint) { dataFingerprint = fingerprint; }
+
+    /** @brief 64-bit FNV-1a hash of a canonical key. */
+    static uint64_t Hash(const std::string &key);
+
+    /**
+     * @brief Look up the measures of a structure.
+     *
+     * @param structure        Decoded model structure.
+     * @param fitness_measures Filled with the stored measures on a hit.
+     * @return true on a hit.
+     */
+    bool Lookup(const CModelStructure_Multi &structure, std::map<std::string, double> &fitness_measures);
+
+    /** @brief Insert (or overwrite) the measures of a structure. */
+    void Store(const CModelStructure_Multi &structure, const std::map<std::string, double> &fitness_measures);
+
+    /** @brief Number of stored structures. */
+    size_t size() const { return entries.size(); }
+
+    /** @brief Remove all entries and reset the hit/miss counters. */
+    void clear();
+
+    /**
+     * @brief Write all entries, one per line: key<TAB>name=value;name=value;...
+     */
+    bool Save(std::ostream &out) const;
+    bool Save(const std::string &filename) const;
+
+    /**
+     * @brief Merge entries previously written by Save().
+     *
+     * @return false if the stream/file could not be read, or it was written
+     *         for another data fingerprint (nothing is merged then).
+     */
+    bool Load(std::istream &in);
+    bool Load(const std::string &filename);
+
+    unsigned long hits = 0;    ///< Successful lookups since construction/clear().
+    unsigned long misses = 0;  ///< Failed lookups since construction/clear().
+
+private:
+
+    struct Entry
+    {
+        std::string key;
+        std::map<std::string, double> fitness_measures;
+    };
+
+    void Store(const std::string &key, const std::map<std::string, double> &fitness_measures);
+
+    std::unordered_map<uint64_t, Entry> entries;
+    std::string dataFingerprint;
+
+    static const std::string DataHeader;
+};
@@ -1,10 +1,13 @@
 #ifndef GeneticAlgorithm_H
 #define GeneticAlgorithm_H
 
+#include <random>
 #include <vector>
 
 #include "Binary.h"
 #include "individual.h"
+#include "fitnesscache.h"
+#include "gacheckpoint.h"
 
 struct GeneticAlgorithmsettings
 {
@@ -19,6 +22,17 @@ struct GeneticAlgorithmsettings
     string outputpath = "/home/behzad/Projects/FFNWrapper2/ASM/Results/";
 #endif
     bool MSE_optimization = true; // true for MSE_Test minimization and false for (MSE_Test + MSE_Train) minimization
+    bool parallel_evaluation = true; // train the candidates of a generation concurrently, each in its own output slot
+    unsigned int numthreads = 8; // OpenMP threads used for fitness evaluation
+    bool fitness_cache = true; // reuse the fitness of structures that were already trained
+    string fitness_cache_file = ""; // if not empty, the cache is loaded from and saved to this file
+    unsigned long random_seed = 42; // seeds the GA's random engine (initial population, mutation, selection)
+    bool steady_state = false; // workers breed, train and insert one offspring at a time instead of waiting for whole generations
+    unsigned int steady_state_evaluations = 0; // offspring trained in steady-state mode (0 = generations x totalpopulation)
+    string checkpoint_file = ""; // if not empty, the GA state is saved here after every generation and a run resumes from it
+    bool successive_halving = false; // train new candidates on a few epochs first and promote only the best to full training
+    unsigned int fidelity_rungs = 3; // budgets epochs/eta^(rungs-1), ..., epochs/eta, epochs
+    unsigned int halving_rate = 3; // eta: the best 1/eta of each rung is promoted to the next
 };
 
 using namespace std;
@@ -29,6 +43,7 @@ class GeneticAlgorithm
 public:
     GeneticAlgorithm();
     T Optimize();
+    T OptimizeSteadyState();
     void AssignFitnesses();
     void Initialize();
     void WriteToFile();
@@ -36,10 +51,23 @@ public:
     T model;
     vector<T> models;
     GeneticAlgorithmsettings Settings;
-    std::vector<int> getRanks();
+    CFitnessCache FitnessCache;
+    std::vector<int> getRanks(); // ranks Individuals by fitness, sets max_rank and rebuilds the selection table
     void CrossOver();
     const Individual& selectIndividualByRank();
+    std::mt19937_64 rng; // the only source of randomness of the GA, seeded from Settings.random_seed
+    bool SaveCheckpoint(unsigned int next_generation);
+    bool ResumeFromCheckpoint(unsigned int &next_generation);
+    std::vector<uint32_t> GeneDigits(); // digits of every gene of model, the checkpoint fingerprint
 private:
+    void buildSelectionTable(); // cumulative 1/rank weights of Individuals, for selectIndividualByRank(); called by getRanks()
+    void EvaluateSuccessiveHalving(const vector<int> &evaluate); // multi-fidelity training of models[evaluate]
+    vector<double> selectionCumulative;
+    void Decode(T &candidate, const Individual &individual);
+    void Evaluate(T &candidate, Individual &individual);
+    void AssignFitness(T &candidate, Individual &individual);
+    void Report(unsigned int i);
+    vector<bool> trained; // whether models[i] was actually trained on its current chromosome
     unsigned int max_rank=0;
     std::ofstream file;
     unsigned int current_generation=0;
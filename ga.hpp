@@ -1,34 +1,280 @@
 #include "ga.h"
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <sstream>
 #include <omp.h>
 #include "Utilities.h"
 
 template<class T>
 GeneticAlgorithm<T>::GeneticAlgorithm()
 {
-    omp_set_num_threads(8);
+    omp_set_num_threads(Settings.numthreads);
 }
 
 
 template<class T>
 T GeneticAlgorithm<T>::Optimize()
 {
-    Initialize();
-    WriteToFile();
-    file.open(Settings.outputpath+"/GA_Output.txt", std::ios::out);
-    file.close();
-    for (current_generation=0; current_generation<Settings.generations; current_generation++)
+    if (Settings.steady_state)
+        return OptimizeSteadyState();
+
+    rng.seed(Settings.random_seed);
+    unsigned int first_generation = 0;
+    if (!ResumeFromCheckpoint(first_generation))
+    {
+        Initialize();
+        WriteToFile();
+        file.open(Settings.outputpath+"/GA_Output.txt", std::ios::out);
+        file.close();
+        SaveCheckpoint(0);
+    }
+    for (current_generation=first_generation; current_generation<Settings.generations; current_generation++)
     {
         cout<<"Generation: "<<current_generation<<endl;
         CrossOver();
         AssignFitnesses();
         WriteToFile();
+        SaveCheckpoint(current_generation + 1);
+    }
+
+    // A finished run must not be resumed by the next one
+    if (!Settings.checkpoint_file.empty())
+        std::remove(Settings.checkpoint_file.c_str());
+
+    // The best fitness may have come from the cache; train it so the returned model carries a network
+    if (!trained[max_rank])
+        models[max_rank].Fitness();
+
+    return models[max_rank];
+
+}
+
+
+// Steady-state evolution: every worker repeatedly breeds one offspring from the current
+// population, trains it, and replaces the worst individual if the offspring is better.
+// Nobody waits for the slowest candidate of a generation. The population and the RNG are
+// only touched inside the ga_population critical section; training runs outside it.
+template<class T>
+T GeneticAlgorithm<T>::OptimizeSteadyState()
+{
+    rng.seed(Settings.random_seed);
+    unsigned int resumed_generations = 0;
+    if (!ResumeFromCheckpoint(resumed_generations))
+    {
+        Initialize();
+        file.open(Settings.outputpath+"/GA_Output.txt", std::ios::out);
+        file.close();
+        WriteToFile();
+        SaveCheckpoint(0);
     }
+    current_generation = resumed_generations;
+
+    const unsigned int total = Settings.steady_state_evaluations > 0
+                                   ? Settings.steady_state_evaluations
+                                   : Settings.generations * Settings.totalpopulation;
+    // Checkpoints are taken every population-size offspring; offspring in training at that moment are bred again
+    unsigned int produced = resumed_generations * Settings.totalpopulation;
+    unsigned int completed = produced, inserted = 0, evaluations = 0;
+    const auto start = std::chrono::steady_clock::now();
+    auto perHour = [&start](unsigned int n) {
+        const double hours = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / 3600.0;
+        return hours > 0 ? n / hours : 0.0;
+    };
+
+    cout<<"Steady-state GA: "<<total<<" offspring on "<<(Settings.parallel_evaluation ? Settings.numthreads : 1)<<" workers"<<endl;
+
+    #pragma omp parallel num_threads(Settings.parallel_evaluation ? Settings.numthreads : 1)
+    {
+        BinaryNumber FullBinary;
+        while (true)
+        {
+            // Breed: select, mutate and decode under the lock
+            Individual child;
+            T candidate = model;
+            bool cached = false;
+            #pragma omp critical(ga_population)
+            {
+                if (produced < total)
+                {
+                    produced++;
+                    const Individual &parent = selectIndividualByRank();
+                    child = parent;
+                    parent.toBinary(FullBinary);
+                    FullBinary.mutate(Settings.mutation_probability, rng);
+                    FullBinary.split(parent.splitlocations, child);
+                    Decode(candidate, child);
+                    if (Settings.fitness_cache && candidate.FFN.ModelStructure.ValidLags()
+                        && FitnessCache.Lookup(candidate.FFN.ModelStructure, child.fitness_measures))
+                    {
+                        AssignFitness(candidate, child);
+                        cached = true;
+                    }
+                }
+                else
+                    child.clear();
+            }
+            if (child.empty())
+                break;
+
+            // Train outside the lock
+            if (!cached)
+            {
+                Evaluate(candidate, child);
+                child.fitness_measures["fidelity"] = 1;
+            }
+
+            // Insert: replace the worst individual if the offspring beats it
+            #pragma omp critical(ga_population)
+            {
+                completed++;
+                if (!cached)
+                {
+                    evaluations++;
+                    if (Settings.fitness_cache && candidate.FFN.ModelStructure.ValidLags())
+                        FitnessCache.Store(candidate.FFN.ModelStructure, child.fitness_measures);
+                }
+
+                size_t worst = 0;
+                for (size_t i = 1; i < Individuals.size(); i++)
+                    if (Individuals[i].fitness > Individuals[worst].fitness)
+                        worst = i;
+
+                if (child.fitness < Individuals[worst].fitness)
+                {
+                    Individuals[worst] = child;
+                    models[worst] = candidate;
+                    trained[worst] = !cached;
+                    getRanks();
+                    inserted++;
+                }
+
+                #pragma omp critical(ga_console)
+                cout<<"Offspring "<<completed<<"/"<<total<<": fitness "<<child.fitness
+                    <<(cached ? " (cached)" : "")<<", best "<<Individuals[max_rank].fitness
+                    <<", "<<perHour(evaluations)<<" evaluations/hour"<<endl;
+
+                // A pseudo-generation per population-size offspring keeps GA_Output.txt comparable
+                if (completed % Settings.totalpopulation == 0)
+                {
+                    current_generation++;
+                    WriteToFile();
+                    if (Settings.fitness_cache && !Settings.fitness_cache_file.empty())
+                        FitnessCache.Save(Settings.fitness_cache_file);
+                    SaveCheckpoint(current_generation);
+                }
+            }
+        }
+    }
+
+    if (!Settings.checkpoint_file.empty())
+        std::remove(Settings.checkpoint_file.c_str());
+
+    cout<<"Steady-state GA finished: "<<evaluations<<" trained, "<<(completed - evaluations)<<" cached, "
+        <<inserted<<" inserted, "<<perHour(evaluations)<<" evaluations/hour"<<endl;
+    if (Settings.fitness_cache && !Settings.fitness_cache_file.empty())
+        FitnessCache.Save(Settings.fitness_cache_file);
+
+    // The best individual may come from the cache; train it so the returned model carries a network
+    if (!trained[max_rank])
+    {
+        Decode(models[max_rank], Individuals[max_rank]);
+        models[max_rank].Fitness();
+    }
+
     return models[max_rank];
+}
+
+template<class T>
+bool GeneticAlgorithm<T>::SaveCheckpoint(unsigned int next_generation)
+{
+    if (Settings.checkpoint_file.empty())
+        return false;
+
+    CGACheckpoint checkpoint;
+    checkpoint.next_generation = next_generation;
+    checkpoint.max_rank = max_rank;
+    checkpoint.individuals = Individuals;
+
+    std::ostringstream rng_state;
+    rng_state << rng;
+    checkpoint.rng_state = rng_state.str();
+
+    std::ostringstream cache;
+    FitnessCache.Save(cache);
+    checkpoint.fitness_cache = cache.str();
+
+    checkpoint.totalpopulation = Settings.totalpopulation;
+    checkpoint.random_seed = Settings.random_seed;
+    checkpoint.gene_digits = GeneDigits();
+
+    if (!checkpoint.Save(Settings.checkpoint_file))
+    {
+        cout<<"Could not write GA checkpoint "<<Settings.checkpoint_file<<endl;
+        return false;
+    }
+    return true;
+}
+
+// Restores the population, ranks, RNG and fitness cache; nothing is retrained. The networks
+// are not part of the checkpoint, so the returned best model is retrained at the end if needed.
+template<class T>
+bool GeneticAlgorithm<T>::ResumeFromCheckpoint(unsigned int &next_generation)
+{
+    if (Settings.checkpoint_file.empty())
+        return false;
+
+    CGACheckpoint checkpoint;
+    if (!checkpoint.Load(Settings.checkpoint_file))
+        return false;
+
+    // A checkpoint of a run with another population, seed or gene layout would decode wrongly
+    if (!checkpoint.Matches(Settings.totalpopulation, Settings.random_seed, GeneDigits()))
+    {
+        cout<<"Warning: GA checkpoint "<<Settings.checkpoint_file<<" belongs to a run with a different population size, "
+            <<"seed or model ranges; starting a new run"<<endl;
+        return false;
+    }
 
+    std::istringstream cache(checkpoint.fitness_cache);
+    FitnessCache.clear();
+    FitnessCache.SetDataFingerprint(CFitnessCache::DataFingerprint(model.FFN.ModelStructure));
+    if (!FitnessCache.Load(cache))
+    {
+        cout<<"Warning: GA checkpoint "<<Settings.checkpoint_file<<" was computed on other train/test data; starting a new run"<<endl;
+        FitnessCache.clear();
+        return false;
+    }
+    std::istringstream rng_state(checkpoint.rng_state);
+    rng_state >> rng;
+
+    Individuals.swap(checkpoint.individuals);
+    max_rank = checkpoint.max_rank;
+    next_generation = checkpoint.next_generation;
+
+    models.assign(Individuals.size(), model);
+    trained.assign(Individuals.size(), false);
+    for (unsigned int i=0; i<Individuals.size(); i++)
+        Decode(models[i], Individuals[i]);
+    getRanks();
+
+    cout<<"Resumed GA from "<<Settings.checkpoint_file<<" at generation "<<next_generation
+        <<" ("<<Individuals.size()<<" individuals, "<<FitnessCache.size()<<" cached structures)"<<endl;
+    return true;
 }
 
+template<class T>
+std::vector<uint32_t> GeneticAlgorithm<T>::GeneDigits()
+{
+    std::vector<uint32_t> digits;
+    for (int j=0; j<model.ParametersSize(); j++)
+        digits.push_back(BinaryNumber::digitsForMaxDecimal(model.MaxParameter(j)));
+    return digits;
+}
 
 template<class T>
 void GeneticAlgorithm<T>::WriteToFile()
@@ -62,19 +308,23 @@ void GeneticAlgorithm<T>::WriteToFile()
 template<class T>
 void GeneticAlgorithm<T>::Initialize()
 {
+    FitnessCache.SetDataFingerprint(CFitnessCache::DataFingerprint(model.FFN.ModelStructure));
+    if (Settings.fitness_cache && !Settings.fitness_cache_file.empty() && FitnessCache.Load(Settings.fitness_cache_file))
+        cout<<"Fitness cache loaded: "<<FitnessCache.size()<<" structures"<<endl;
+
     Individuals.resize(Settings.totalpopulation);
     models.resize(Settings.totalpopulation);
     for (int i=0; i<Individuals.size(); i++)
     {
         models[i] = model;
         Individuals[i].resize(model.ParametersSize());
-        vector<int> splitlocations;
+        Individuals[i].splitlocations.clear();
         for (int j=0; j<model.ParametersSize(); j++)
         {
-            BinaryNumber B = BinaryNumber::randomBinary(model.MaxParameter(j));
-            B.fixSize(BinaryNumber::decimalToBinary(model.MaxParameter(j)).numDigits());
-            Individuals[i][j] = B;
-            Individuals[i].splitlocations.push_back(BinaryNumber::decimalToBinary(model.MaxParameter(j)).numDigits());
+            const unsigned int digits = BinaryNumber::digitsForMaxDecimal(model.MaxParameter(j));
+            Individuals[i][j] = BinaryNumber::randomBinary(model.MaxParameter(j), rng);
+            Individuals[i][j].fixSize(digits);
+            Individuals[i].splitlocations.push_back(digits);
         }
         Individuals[i].display();
 
@@ -86,55 +336,185 @@ void GeneticAlgorithm<T>::Initialize()
 template<class T>
 void GeneticAlgorithm<T>::AssignFitnesses()
 {
-    //#pragma omp parallel for
+    trained.assign(models.size(), false);
+
+    // Decoding is cheap and touches the shared Individuals and cache, so it stays sequential.
+    // Cached structures are not retrained, and identical structures within this generation
+    // are trained once and shared.
+    vector<int> evaluate;
+    vector<int> duplicate_of(models.size(), -1);
+    map<string, int> pending;
     for (unsigned int i=0; i<models.size(); i++)
     {
+        Decode(models[i], Individuals[i]);
+        cout<<"Pre-Train: "<<i<<":"<<models[i].FFN.ModelStructure.ParametersToString().toStdString()<<endl; // Debugger
 
-        //std::cout<<"Number of threads: " << omp_get_num_threads() << ", This thread: " << omp_get_thread_num() << std::endl;
-        vector<unsigned long int> parameterset;
-        for (unsigned int j=0; j<models[i].ParametersSize(); j++)
+        if (Settings.fitness_cache && models[i].FFN.ModelStructure.ValidLags())
         {
-            parameterset.push_back(Individuals[i][j].toDecimal());
-
+            if (FitnessCache.Lookup(models[i].FFN.ModelStructure, Individuals[i].fitness_measures))
+            {
+                AssignFitness(models[i], Individuals[i]);
+                cout<<"Cached: ";
+                Report(i);
+                continue;
+            }
+            string key = CFitnessCache::Key(models[i].FFN.ModelStructure);
+            if (pending.count(key))
+            {
+                duplicate_of[i] = pending[key];
+                continue;
+            }
+            pending[key] = i;
         }
-        models[i].AssignParameters(parameterset);
-        models[i].CreateModel();
-        cout<<"Pre-Train: "<<i<<":"<<models[i].FFN.ModelStructure.ParametersToString().toStdString()<<endl; // Debugger
-        if (models[i].FFN.ModelStructure.ValidLags())
+        evaluate.push_back(i);
+    }
+
+    // Every candidate owns its ModelCreator/FFNWrapper_Multi, so training is independent.
+    // Dynamic scheduling because candidate cost varies wildly with layers, nodes and lags.
+    if (Settings.successive_halving && evaluate.size() > 1)
+        EvaluateSuccessiveHalving(evaluate);
+    else
+    {
+        #pragma omp parallel for schedule(dynamic,1) num_threads(Settings.numthreads) if(Settings.parallel_evaluation)
+        for (int k=0; k<static_cast<int>(evaluate.size()); k++)
         {
-            Individuals[i].fitness_measures = models[i].Fitness();
-            Individuals[i].fitness=0;
-            for (int constituent = 0; constituent<models[i].FFN.ModelStructure.outputcolumns.size(); constituent++)
-                if (Settings.MSE_optimization) // true for MSE_Test and false for (MSE_Test + MSE_Train)
-                Individuals[i].fitness += Individuals[i].fitness_measures["MSE_Test_" + aquiutils::numbertostring(constituent)]; // MSE_Test
-                else
-                Individuals[i].fitness += max(Individuals[i].fitness_measures["MSE_Test_" + aquiutils::numbertostring(constituent)],Individuals[i].fitness_measures["MSE_Train_" + aquiutils::numbertostring(constituent)]); // MSE_Test and MSE_Train
+            const int i = evaluate[k];
+            Evaluate(models[i], Individuals[i]);
+            Individuals[i].fitness_measures["fidelity"] = 1;
+            trained[i] = true;
+
+            #pragma omp critical(ga_console)
+            Report(i);
         }
-        else
+    }
+
+    for (unsigned int i=0; i<models.size(); i++)
+    {
+        if (duplicate_of[i] >= 0)
         {
-            for (int constituent = 0; constituent<models[i].FFN.ModelStructure.outputcolumns.size(); constituent++)
-            {   Individuals[i].fitness_measures["MSE_Test_"+ aquiutils::numbertostring(constituent)]=1e12;
-                Individuals[i].fitness_measures["R2_Test_"+ aquiutils::numbertostring(constituent)]=0;
-                Individuals[i].fitness += Individuals[i].fitness_measures["MSE_Test_" + aquiutils::numbertostring(constituent)];
-            }
+            Individuals[i].fitness_measures = Individuals[duplicate_of[i]].fitness_measures;
+            Individuals[i].fitness = Individuals[duplicate_of[i]].fitness;
         }
-        cout<<i<<":"<<models[i].FFN.ModelStructure.ParametersToString().toStdString();
+        else if (Settings.fitness_cache && trained[i] && models[i].FFN.ModelStructure.ValidLags())
+            FitnessCache.Store(models[i].FFN.ModelStructure, Individuals[i].fitness_measures);
+    }
 
-        for (int constituent = 0; constituent<models[i].FFN.ModelStructure.outputcolumns.size(); constituent++)
-            cout<< ","<<Individuals[i].toAssignmentText("MSE_Train",constituent)<<","<<Individuals[i].toAssignmentText("R2_Train",constituent);
+    if (Settings.fitness_cache)
+    {
+        cout<<"Fitness cache: "<<FitnessCache.size()<<" structures, "<<FitnessCache.hits<<" hits, "<<FitnessCache.misses<<" misses"<<endl;
+        if (!Settings.fitness_cache_file.empty())
+            FitnessCache.Save(Settings.fitness_cache_file);
+    }
 
-        for (int constituent = 0; constituent<models[i].FFN.ModelStructure.outputcolumns.size(); constituent++)
-            cout<< ","<<Individuals[i].toAssignmentText("MSE_Test",constituent)<<","<<Individuals[i].toAssignmentText("R2_Test",constituent);
-        cout<< endl;
+    getRanks();
+}
+
+// Successive halving: all candidates are trained with epochs/eta^(rungs-1), the best 1/eta of
+// them again with eta times more epochs, and so on until the last rung trains with the full
+// budget. Candidates dropped early keep the fitness of their last rung; fitness_measures["fidelity"]
+// records that budget as a fraction of the full epochs. Only full-fidelity results count as trained
+// (and enter the fitness cache).
+template<class T>
+void GeneticAlgorithm<T>::EvaluateSuccessiveHalving(const vector<int> &evaluate)
+{
+    const unsigned int rungs = std::max(1u, Settings.fidelity_rungs);
+    const double eta = std::max(2u, Settings.halving_rate);
+    const size_t full_epochs = models[evaluate[0]].FFN.ModelStructure.training.epochs;
+
+    vector<int> rung = evaluate;
+    for (unsigned int r = 0; r < rungs && !rung.empty(); r++)
+    {
+        const bool last = (r + 1 == rungs);
+        const double fidelity = last ? 1.0 : std::pow(eta, -static_cast<double>(rungs - 1 - r));
+        const size_t epochs = last ? full_epochs
+                                   : std::max<size_t>(1, static_cast<size_t>(std::llround(full_epochs * fidelity)));
+
+        cout<<"Fidelity rung "<<r + 1<<"/"<<rungs<<": "<<rung.size()<<" candidates, "<<epochs<<" epochs"<<endl;
+
+        #pragma omp parallel for schedule(dynamic,1) num_threads(Settings.numthreads) if(Settings.parallel_evaluation)
+        for (int k=0; k<static_cast<int>(rung.size()); k++)
+        {
+            const int i = rung[k];
+            models[i].FFN.ModelStructure.training.epochs = epochs;
+            Evaluate(models[i], Individuals[i]);
+            Individuals[i].fitness_measures["fidelity"] = last || full_epochs == 0 ? 1.0 : static_cast<double>(epochs) / full_epochs;
+            trained[i] = last;
+
+            #pragma omp critical(ga_console)
+            Report(i);
+        }
+
+        // Promote the best ceil(n / eta) to the next rung
+        std::stable_sort(rung.begin(), rung.end(), [this](int a, int b) {
+            return Individuals[a].fitness < Individuals[b].fitness;
+        });
+        rung.resize(std::max<size_t>(1, static_cast<size_t>(std::ceil(rung.size() / eta))));
     }
 
+    for (int i : evaluate)
+        models[i].FFN.ModelStructure.training.epochs = full_epochs;
+}
 
+template<class T>
+void GeneticAlgorithm<T>::Report(unsigned int i)
+{
+    cout<<i<<":"<<models[i].FFN.ModelStructure.ParametersToString().toStdString();
 
-    vector<int> ranks = getRanks();
-    for (unsigned int i=0; i<Individuals.size(); i++)
+    for (int constituent = 0; constituent<models[i].FFN.ModelStructure.outputcolumns.size(); constituent++)
+        cout<< ","<<Individuals[i].toAssignmentText("MSE_Train",constituent)<<","<<Individuals[i].toAssignmentText("R2_Train",constituent);
+
+    for (int constituent = 0; constituent<models[i].FFN.ModelStructure.outputcolumns.size(); constituent++)
+        cout<< ","<<Individuals[i].toAssignmentText("MSE_Test",constituent)<<","<<Individuals[i].toAssignmentText("R2_Test",constituent);
+
+    if (Individuals[i].fitness_measures.count("fidelity"))
+        cout<< ",fidelity="<<Individuals[i].fitness_measures["fidelity"];
+    cout<< endl;
+}
+
+template<class T>
+void GeneticAlgorithm<T>::Decode(T &candidate, const Individual &individual)
+{
+    vector<unsigned long int> parameterset;
+    for (unsigned int j=0; j<candidate.ParametersSize(); j++)
     {
-        Individuals[i].rank = ranks[i];
+        parameterset.push_back(individual[j].toDecimal());
     }
+    candidate.AssignParameters(parameterset);
+    candidate.CreateModel();
+}
+
+template<class T>
+void GeneticAlgorithm<T>::Evaluate(T &candidate, Individual &individual)
+{
+    if (candidate.FFN.ModelStructure.ValidLags())
+    {
+        // Parallel workers write their intermediate files into a private slot
+        string sharedpath = candidate.FFN.ModelStructure.outputpath;
+        if (omp_in_parallel())
+            candidate.FFN.ModelStructure.IsolateOutputPath("worker_" + aquiutils::numbertostring(omp_get_thread_num()));
+
+        individual.fitness_measures = candidate.Fitness();
+        candidate.FFN.ModelStructure.outputpath = sharedpath;
+    }
+    else
+    {
+        for (int constituent = 0; constituent<candidate.FFN.ModelStructure.outputcolumns.size(); constituent++)
+        {   individual.fitness_measures["MSE_Test_"+ aquiutils::numbertostring(constituent)]=1e12;
+            individual.fitness_measures["R2_Test_"+ aquiutils::numbertostring(constituent)]=0;
+        }
+    }
+    AssignFitness(candidate, individual);
+}
+
+template<class T>
+void GeneticAlgorithm<T>::AssignFitness(T &candidate, Individual &individual)
+{
+    individual.fitness = 0;
+    for (int constituent = 0; constituent<candidate.FFN.ModelStructure.outputcolumns.size(); constituent++)
+        if (Settings.MSE_optimization || !candidate.FFN.ModelStructure.ValidLags()) // true for MSE_Test and false for (MSE_Test + MSE_Train)
+        individual.fitness += individual.fitness_measures["MSE_Test_" + aquiutils::numbertostring(constituent)]; // MSE_Test
+        else
+        individual.fitness += max(individual.fitness_measures["MSE_Test_" + aquiutils::numbertostring(constituent)],individual.fitness_measures["MSE_Train_" + aquiutils::numbertostring(constituent)]); // MSE_Test and MSE_Train
 }
 
 template<class T>
@@ -142,66 +522,38 @@ void GeneticAlgorithm<T>::CrossOver()
 {
     vector<Individual> newIndividuals = Individuals;
     newIndividuals[0] = Individuals[max_rank];
+    BinaryNumber FullBinary; // reused, so the loop does not allocate once it has grown
     for (unsigned int i=1; i<Individuals.size(); i++)
     {
-        Individual Ind1 = selectIndividualByRank();
-        Individual Ind2 = selectIndividualByRank();
-        BinaryNumber FullBinary = Ind1.toBinary();
-        FullBinary.mutate(Settings.mutation_probability);
-        newIndividuals[i] = FullBinary.split(Individuals[i].splitlocations);
+        const Individual &Ind1 = selectIndividualByRank();
+        Ind1.toBinary(FullBinary);
+        FullBinary.mutate(Settings.mutation_probability, rng);
+        FullBinary.split(Individuals[i].splitlocations, newIndividuals[i]);
     }
-    Individuals = newIndividuals;
+    Individuals.swap(newIndividuals);
 }
 
 
-// Function to randomly select an Individual based on inverse rank probability
+// Randomly select an Individual with probability proportional to 1/rank
 template<class T>
 const Individual& GeneticAlgorithm<T>::selectIndividualByRank() {
-    // Calculate weights as the inverse of rank
-    std::vector<double> weights(Individuals.size());
-    for (size_t i = 0; i < Individuals.size(); ++i) {
-        weights[i] = 1.0 / Individuals[i].rank;
-    }
-
-    // Create a cumulative probability distribution
-    std::vector<double> cumulative(weights.size());
-    std::partial_sum(weights.begin(), weights.end(), cumulative.begin());
-
-    // Normalize the cumulative probabilities
-    double totalWeight = cumulative.back();
-    for (double& value : cumulative) {
-        value /= totalWeight;
-    }
-
-    // Generate a random number between 0 and 1
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(0.0, 1.0);
-    double randomValue = dis(gen);
-
-    // Find the corresponding individual
-    for (size_t i = 0; i < cumulative.size(); ++i) {
-        if (randomValue <= cumulative[i]) {
-            return Individuals[i];
-        }
-    }
-
-    // Fallback (shouldn't be reached)
-    return Individuals.back();
+    // selectionCumulative is rebuilt by getRanks() whenever the ranks change
+    std::uniform_real_distribution<> dis(0.0, selectionCumulative.back());
+    const double randomValue = dis(rng);
+
+    // First individual whose cumulative weight exceeds the draw
+    size_t i = std::upper_bound(selectionCumulative.begin(), selectionCumulative.end(), randomValue)
+               - selectionCumulative.begin();
+    return Individuals[std::min(i, Individuals.size() - 1)];
 }
 
-void SortIndices(const std::vector<Individual>& individuals, std::vector<int>& indices) {
-    size_t n = indices.size();
-
-    // Perform Bubble Sort on indices based on fitness values
-    for (size_t i = 0; i < n - 1; ++i) {
-        for (size_t j = 0; j < n - i - 1; ++j) {
-            // Compare fitness values of the indices
-            if (individuals[indices[j]].fitness > individuals[indices[j + 1]].fitness) {
-                // Swap indices
-                std::swap(indices[j], indices[j + 1]);
-            }
-        }
+template<class T>
+void GeneticAlgorithm<T>::buildSelectionTable() {
+    selectionCumulative.resize(Individuals.size());
+    double total = 0;
+    for (size_t i = 0; i < Individuals.size(); ++i) {
+        total += 1.0 / Individuals[i].rank;
+        selectionCumulative[i] = total;
     }
 }
 
@@ -209,21 +561,21 @@ template<class T>
 std::vector<int> GeneticAlgorithm<T>::getRanks() {
     size_t n = Individuals.size();
 
-    // Create a vector of indices from 0 to n-1
+    // Indices ordered by fitness; stable, so ties keep their population order
     std::vector<int> indices(n);
-    for (size_t i = 0; i < n; ++i) {
-        indices[i] = i;
-    }
-
-    // Sort indices based on fitness using our custom bubble sort
-    SortIndices(Individuals, indices);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::stable_sort(indices.begin(), indices.end(), [this](int a, int b) {
+        return Individuals[a].fitness < Individuals[b].fitness;
+    });
 
     // Create a vector to store ranks
     std::vector<int> ranks(n);
     for (size_t i = 0; i < n; ++i) {
         ranks[indices[i]] = i + 1; // Rank starts from 1
     }
+    for (size_t i = 0; i < n; ++i)
+        Individuals[i].rank = ranks[i];
     max_rank = indices[0];
+    buildSelectionTable();
     return ranks;
 }
-
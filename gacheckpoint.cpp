@@ -0,0 +1,199 @@
+/**
+ * @file gacheckpoint.cpp
+ * @brief Implements CGACheckpoint (see gacheckpoint.h).
+ */
+
+#include "gacheckpoint.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+    const char     CheckpointMagic[8] = {'F', 'F', 'N', 'G', 'A', 'C', 'K', '\0'};
+    const uint32_t CheckpointVersion  = 2;
+
+    template<typename V>
+    void WriteValue(std::ostream &out, const V &value)
+    {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(V));
+    }
+
+    void WriteString(std::ostream &out, const std::string &value)
+    {
+        WriteValue(out, static_cast<uint64_t>(value.size()));
+        out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    template<typename V>
+    bool ReadValue(std::istream &in, V &value)
+    {
+        return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(V)));
+    }
+
+    bool ReadString(std::istream &in, std::string &value, uint64_t remaining)
+    {
+        uint64_t size = 0;
+        if (!ReadValue(in, size) || size > remaining)   // guard against corrupt lengths
+            return false;
+        value.resize(size);
+        return static_cast<bool>(in.read(&value[0], static_cast<std::streamsize>(size)));
+    }
+}
+
+bool CGACheckpoint::Save(const std::string &filename) const
+{
+    const std::string temporary = filename + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+
+        file.write(CheckpointMagic, sizeof(CheckpointMagic));
+        WriteValue(file, CheckpointVersion);
+        WriteValue(file, next_generation);
+        WriteValue(file, max_rank);
+        WriteValue(file, static_cast<uint32_t>(individuals.size()));
+
+        WriteValue(file, totalpopulation);
+        WriteValue(file, random_seed);
+        WriteValue(file, static_cast<uint32_t>(gene_digits.size()));
+        for (uint32_t digits : gene_digits)
+            WriteValue(file, digits);
+
+        for (const Individual &individual : individuals)
+        {
+            WriteValue(file, static_cast<uint32_t>(individual.size()));
+            for (const BinaryNumber &gene : individual)
+                WriteString(file, gene.getBinary());
+
+            WriteValue(file, static_cast<uint32_t>(individual.splitlocations.size()));
+            for (unsigned int length : individual.splitlocations)
+                WriteValue(file, static_cast<uint32_t>(length));
+
+            WriteValue(file, individual.fitness);
+            WriteValue(file, static_cast<uint32_t>(individual.rank));
+
+            WriteValue(file, static_cast<uint32_t>(individual.fitness_measures.size()));
+            for (const auto &measure : individual.fitness_measures)
+            {
+                WriteString(file, measure.first);
+                WriteValue(file, measure.second);
+            }
+        }
+
+        WriteString(file, rng_state);
+        WriteString(file, fitness_cache);
+
+        if (!file)
+        {
+            std::cerr << "[GA] Could not write checkpoint " << temporary << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporary, filename, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
+
+bool CGACheckpoint::Load(const std::string &filename)
+{
+    std::error_code ec;
+    const uint64_t fileSize = std::filesystem::file_size(filename, ec);
+    if (ec)
+        return false;
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    char magic[8];
+    uint32_t version = 0, population = 0;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, CheckpointMagic, sizeof(magic)) != 0 ||
+        !ReadValue(file, version) || version != CheckpointVersion ||
+        !ReadValue(file, next_generation) || !ReadValue(file, max_rank) || !ReadValue(file, population))
+        return false;
+
+    uint32_t fingerprintGenes = 0;
+    if (!ReadValue(file, totalpopulation) || !ReadValue(file, random_seed) || !ReadValue(file, fingerprintGenes) ||
+        fingerprintGenes > fileSize)
+        return false;
+    gene_digits.resize(fingerprintGenes);
+    for (uint32_t &digits : gene_digits)
+        if (!ReadValue(file, digits))
+            return false;
+
+    std::vector<Individual> loaded(population);
+    for (Individual &individual : loaded)
+    {
+        uint32_t genes = 0;
+        if (!ReadValue(file, genes))
+            return false;
+        individual.resize(genes);
+        for (BinaryNumber &gene : individual)
+        {
+            std::string digits;
+            if (!ReadString(file, digits, fileSize))
+                return false;
+            gene.setBinary(digits);
+        }
+
+        uint32_t splits = 0;
+        if (!ReadValue(file, splits))
+            return false;
+        individual.splitlocations.resize(splits);
+        for (unsigned int &length : individual.splitlocations)
+        {
+            uint32_t value = 0;
+            if (!ReadValue(file, value))
+                return false;
+            length = value;
+        }
+
+        uint32_t rank = 0, measures = 0;
+        if (!ReadValue(file, individual.fitness) || !ReadValue(file, rank) || !ReadValue(file, measures))
+            return false;
+        individual.rank = rank;
+
+        for (uint32_t m = 0; m < measures; m++)
+        {
+            std::string name;
+            double value = 0;
+            if (!ReadString(file, name, fileSize) || !ReadValue(file, value))
+                return false;
+            individual.fitness_measures[name] = value;
+        }
+    }
+
+    if (!ReadString(file, rng_state, fileSize) || !ReadString(file, fitness_cache, fileSize))
+        return false;
+    if (max_rank >= loaded.size())
+        return false;
+
+    individuals.swap(loaded);
+    return true;
+}
+
+bool CGACheckpoint::Matches(uint32_t population, uint64_t seed, const std::vector<uint32_t> &digits) const
+{
+    if (totalpopulation != population || random_seed != seed || gene_digits != digits)
+        return false;
+
+    for (const Individual &individual : individuals)
+    {
+        if (individual.size() != digits.size() || individual.splitlocations.size() != digits.size())
+            return false;
+        for (size_t j = 0; j < digits.size(); j++)
+            if (individual[j].numDigits() != digits[j] || individual.splitlocations[j] != digits[j])
+                return false;
+    }
+    return true;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file gacheckpoint.h
+ * @brief Declares CGACheckpoint, the restorable state of a GeneticAlgorithm run.
+ *
+ * @details
+ * GA_Output.txt is a log for people; it cannot restart a run. A checkpoint
+ * holds everything the GA needs to continue where it stopped without training
+ * any individual again:
+ *
+ * - the next generation to breed,
+ * - every Individual (chromosome, split locations, fitness, fitness measures, rank),
+ * - the index of the best individual,
+ * - the state of the GA's random engine,
+ * - the fitness cache, in the text form of CFitnessCache::Save(),
+ * - a fingerprint of the run (population size, seed, digits of every gene),
+ *   so a checkpoint of a differently configured run is not resumed.
+ *
+ * The file is binary:
+ *
+ * | Content                                                        |
+ * |----------------------------------------------------------------|
+ * | magic "FFNGACK\0" (8 bytes), uint32 format version             |
+ * | uint32 next generation, uint32 best index, uint32 population   |
+ * | fingerprint: uint32 total population, uint64 seed,             |
+ * |   uint32 genes, uint32 digits per gene                         |
+ * | per individual: uint32 genes, genes as strings, uint32 splits, |
+ * |   uint32 split lengths, double fitness, uint32 rank,           |
+ * |   uint32 measures, (string name, double value) per measure     |
+ * | string random-engine state, string fitness cache               |
+ *
+ * Strings are a uint64 length followed by the characters. Save() writes a
+ * temporary file and renames it, so a crash during a save leaves the previous
+ * checkpoint intact.
+ *
+ * @see GeneticAlgorithm::SaveCheckpoint()
+ * @see GeneticAlgorithm::ResumeFromCheckpoint()
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "individual.h"
+
+struct CGACheckpoint
+{
+    uint32_t next_generation = 0;       ///< First generation still to be bred.
+    uint32_t max_rank = 0;              ///< Index of the best individual.
+    std::vector<Individual> individuals;
+    std::string rng_state;              ///< std::mt19937_64 written with operator<<.
+    std::string fitness_cache;          ///< CFitnessCache::Save() output.
+
+    // Fingerprint of the run that wrote the checkpoint
+    uint32_t totalpopulation = 0;       ///< GeneticAlgorithmsettings::totalpopulation.
+    uint64_t random_seed = 0;           ///< GeneticAlgorithmsettings::random_seed.
+    std::vector<uint32_t> gene_digits;  ///< Digits of every gene (size = model.ParametersSize()).
+
+    /// True if the checkpoint was written by a run with the same fingerprint
+    /// and every individual has exactly these genes.
+    bool Matches(uint32_t population, uint64_t seed, const std::vector<uint32_t> &digits) const;
+
+    /// Write atomically (temporary file + rename).
+    bool Save(const std::string &filename) const;
+
+    /// Read a checkpoint written by Save(); false if missing, truncated or of another version.
+    bool Load(const std::string &filename);
+};
@@ -76,12 +76,19 @@ public:
     }
     BinaryNumber toBinary() const
     {
-        BinaryNumber B = at(0);
-        for (unsigned int i=1; i<size(); i++)
-            B += at(i);
+        BinaryNumber B;
+        toBinary(B);
         return B;
     }
 
+    // Concatenated chromosome written into B, reusing its storage
+    void toBinary(BinaryNumber &B) const
+    {
+        B.clear();
+        for (unsigned int i=0; i<size(); i++)
+            B += at(i);
+    }
+
     string toAssignmentText(const string &name, int iterator)
     {
         string out = name + "_" + aquiutils::numbertostring(iterator) + "=" + aquiutils::numbertostring(fitness_measures[name + "_" + aquiutils::numbertostring(iterator)]);
@@ -0,0 +1,99 @@
+/**
+ * @file inferenceengine.h
+ * @brief Declares CInferenceEngine, a lightweight forward pass for networks
+ *        trained by FFNWrapper_Multi.
+ *
+ * @details
+ * Predicting through FFNWrapper_Multi needs the whole Initiate() / DataProcess()
+ * / Test() path, which re-reads the data files and refits the scaling. The
+ * engine instead copies, once, everything a prediction needs:
+ *
+ * - the raw-data (PreTransform) and lagged-input scalers, composed into one
+ *   per-input affine map  x' = scale · x + offset;
+ * - the weights of every Linear layer, transposed to row-major so that each
+ *   output neuron is one contiguous dot product;
+ * - the log_output flag of the structure.
+ *
+ * The network built by FFNWrapper_Multi::BuildNetwork() is
+ *
+ *     [Linear(n_nodes[i]) → Sigmoid] × n_layers → ReLU → Linear(n_outputs)
+ *
+ * Every layer is evaluated by one fused kernel (GEMV + bias + activation)
+ * writing into a per-thread scratch buffer, so Predict() on a single sample
+ * allocates nothing after its first call. The ReLU is applied to the input of
+ * the output layer only when there are no hidden layers; after a Sigmoid it is
+ * the identity.
+ *
+ * Weights are stored in the element type @p eT; CInferenceEngine<float> halves
+ * the memory traffic at single-precision accuracy.
+ *
+ * Usage:
+ * @code
+ * CInferenceEngine<double> engine;
+ * engine.LoadBundle(outputpath + "model.ffnb");
+ * engine.Predict(laggedInput.memptr(), prediction.memptr());
+ * @endcode
+ *
+ * @see FFNWrapper_Multi::SaveModel()
+ * @see BenchmarkInferenceLatency()
+ */
+
+#pragma once
+
+#include <armadillo>
+#include <string>
+#include <vector>
+
+class FFNWrapper_Multi;
+
+template<typename eT>
+class CInferenceEngine
+{
+public:
+    CInferenceEngine() = default;
+    explicit CInferenceEngine(const FFNWrapper_Multi& model) { Load(model); }
+
+    /// Copy the weights and scaling of a trained (or loaded) model.
+    bool Load(const FFNWrapper_Multi& model);
+
+    /// Read a bundle written by FFNWrapper_Multi::SaveModel().
+    bool LoadBundle(const std::string& filename);
+
+    /**
+     * @brief Predict one sample.
+     * @param input  InputSize() raw lagged inputs, ordered as the rows of the design matrix.
+     * @param output OutputSize() predictions.
+     */
+    void Predict(const eT* input, eT* output) const;
+
+    /// Predict every column of @p inputs (InputSize() × n) into @p outputs (OutputSize() × n).
+    void Predict(const arma::Mat<eT>& inputs, arma::Mat<eT>& outputs) const;
+
+    bool IsLoaded() const { return !layers.empty(); }
+    size_t InputSize() const { return scale.size(); }
+    size_t OutputSize() const { return layers.empty() ? 0 : layers.back().outSize; }
+
+private:
+    enum class activation { Identity, Sigmoid };
+
+    struct CDenseLayer
+    {
+        size_t inSize;
+        size_t outSize;
+        size_t weightOffset;        // outSize × inSize, row-major
+        size_t biasOffset;          // outSize
+        bool reluInput;             // clamp the input at zero before the product
+        activation outputActivation;
+    };
+
+    void Forward(const CDenseLayer& layer, const eT* input, eT* output) const;
+
+    std::vector<eT> scale;          // composed PreTransform and input scaling, per input
+    std::vector<eT> offset;
+    std::vector<eT> weights;        // all layers, contiguous
+    std::vector<CDenseLayer> layers;
+    size_t maxWidth = 0;            // widest layer, size of each scratch buffer
+    bool expOutput = false;         // the network was trained on log(outputs)
+};
+
+#include "inferenceengine.hpp"
@@ -0,0 +1,211 @@
+#include "inferenceengine.h"
+#include "ffnwrapper_multi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <omp.h>
+#include <QDebug>
+
+template<typename eT>
+bool CInferenceEngine<eT>::Load(const FFNWrapper_Multi& model)
+{
+    const CModelStructure_Multi& ms = model.ModelStructure;
+    const arma::mat& parameters = model.NetworkParameters();
+
+    scale.clear();
+    offset.clear();
+    weights.clear();
+    layers.clear();
+    maxWidth = 0;
+    expOutput = ms.log_output;
+
+    // ───────────────────────────────────────────────
+    // 1️⃣ Compose the scalers into one affine map per input
+    // ───────────────────────────────────────────────
+    // CTransformation::transform(): (x - min) / (max - min), or 0 for a degenerate range
+    auto affine = [](double minVal, double maxVal, double& s, double& o)
+    {
+        const double range = maxVal - minVal;
+        if (!std::isfinite(minVal) || !std::isfinite(maxVal) || range <= 1e-12)
+        {
+            s = 0.0;
+            o = 0.0;
+            return;
+        }
+        s = 1.0 / range;
+        o = -minVal / range;
+    };
+
+    const arma::colvec inputMin = model.GetInputTransformer().GetMinValues();
+    const arma::colvec inputMax = model.GetInputTransformer().GetMaxValues();
+    const arma::colvec preMin = model.GetPreTransformer().GetMinValues();
+    const arma::colvec preMax = model.GetPreTransformer().GetMaxValues();
+    const size_t inputSize = inputMin.n_elem;
+
+    if (inputSize == 0 || ms.n_layers < 0 || ms.n_nodes.size() < static_cast<size_t>(ms.n_layers))
+    {
+        qWarning() << "[InferenceEngine] ❌ Model has no fitted input scaling or an incomplete structure.";
+        return false;
+    }
+    if (ms.preTransformed && preMin.n_elem < inputSize)
+    {
+        qWarning() << "[InferenceEngine] ❌ Pre-transform parameters do not cover all" << inputSize << "inputs.";
+        return false;
+    }
+
+    scale.resize(inputSize);
+    offset.resize(inputSize);
+    for (size_t i = 0; i < inputSize; ++i)
+    {
+        double s2, o2;
+        affine(inputMin(i), inputMax(i), s2, o2);
+
+        double s = s2, o = o2;
+        if (ms.preTransformed)
+        {
+            double s1, o1;
+            affine(preMin(i), preMax(i), s1, o1);
+            s = s2 * s1;
+            o = s2 * o1 + o2;
+        }
+        scale[i] = static_cast<eT>(s);
+        offset[i] = static_cast<eT>(o);
+    }
+
+    // ───────────────────────────────────────────────
+    // 2️⃣ Layer sizes of BuildNetwork(), checked against the parameter count
+    // ───────────────────────────────────────────────
+    std::vector<size_t> widths = { inputSize };
+    for (int l = 0; l < ms.n_layers; ++l)
+        widths.push_back(static_cast<size_t>(ms.n_nodes[l]));
+    widths.push_back(ms.outputcolumns.size());
+
+    size_t expected = 0;
+    for (size_t l = 1; l < widths.size(); ++l)
+        expected += widths[l] * widths[l - 1] + widths[l];
+
+    if (parameters.n_elem != expected)
+    {
+        qWarning() << "[InferenceEngine] ❌ Network has" << parameters.n_elem
+                   << "parameters, the structure implies" << expected;
+        scale.clear();
+        offset.clear();
+        return false;
+    }
+
+    // ───────────────────────────────────────────────
+    // 3️⃣ Copy every Linear layer: weights (column-major in mlpack) → row-major, then bias
+    // ───────────────────────────────────────────────
+    weights.resize(expected);
+    size_t source = 0, target = 0;
+    for (size_t l = 1; l < widths.size(); ++l)
+    {
+        CDenseLayer layer;
+        layer.inSize = widths[l - 1];
+        layer.outSize = widths[l];
+        layer.weightOffset = target;
+        layer.biasOffset = target + layer.outSize * layer.inSize;
+        const bool outputLayer = (l == widths.size() - 1);
+        layer.reluInput = outputLayer && ms.n_layers == 0;
+        layer.outputActivation = outputLayer ? activation::Identity : activation::Sigmoid;
+
+        for (size_t o = 0; o < layer.outSize; ++o)
+            for (size_t i = 0; i < layer.inSize; ++i)
+                weights[layer.weightOffset + o * layer.inSize + i] =
+                    static_cast<eT>(parameters(source + i * layer.outSize + o));
+        source += layer.outSize * layer.inSize;
+
+        for (size_t o = 0; o < layer.outSize; ++o)
+            weights[layer.biasOffset + o] = static_cast<eT>(parameters(source + o));
+        source += layer.outSize;
+
+        target = layer.biasOffset + layer.outSize;
+        maxWidth = std::max(maxWidth, std::max(layer.inSize, layer.outSize));
+        layers.push_back(layer);
+    }
+
+    return true;
+}
+
+template<typename eT>
+bool CInferenceEngine<eT>::LoadBundle(const std::string& filename)
+{
+    FFNWrapper_Multi model;
+    if (!model.LoadModel(filename))
+        return false;
+    return Load(model);
+}
+
+template<typename eT>
+void CInferenceEngine<eT>::Forward(const CDenseLayer& layer, const eT* input, eT* output) const
+{
+    const eT* W = weights.data() + layer.weightOffset;
+    const eT* b = weights.data() + layer.biasOffset;
+    const size_t n = layer.inSize;
+
+    for (size_t o = 0; o < layer.outSize; ++o)
+    {
+        const eT* row = W + o * n;
+        eT sum = 0;
+        if (layer.reluInput)
+        {
+#pragma omp simd reduction(+:sum)
+            for (size_t i = 0; i < n; ++i)
+                sum += row[i] * std::max(input[i], eT(0));
+        }
+        else
+        {
+#pragma omp simd reduction(+:sum)
+            for (size_t i = 0; i < n; ++i)
+                sum += row[i] * input[i];
+        }
+        sum += b[o];
+
+        output[o] = (layer.outputActivation == activation::Sigmoid)
+            ? eT(1) / (eT(1) + std::exp(-sum))
+            : sum;
+    }
+}
+
+template<typename eT>
+void CInferenceEngine<eT>::Predict(const eT* input, eT* output) const
+{
+    if (layers.empty())
+        return;
+
+    // Two ping-pong buffers per thread; allocated on the first call only
+    thread_local std::vector<eT> front, back;
+    if (front.size() < maxWidth) front.resize(maxWidth);
+    if (back.size() < maxWidth)  back.resize(maxWidth);
+
+    const size_t n = scale.size();
+#pragma omp simd
+    for (size_t i = 0; i < n; ++i)
+        front[i] = scale[i] * input[i] + offset[i];
+
+    for (size_t l = 0; l + 1 < layers.size(); ++l)
+    {
+        Forward(layers[l], front.data(), back.data());
+        std::swap(front, back);
+    }
+    Forward(layers.back(), front.data(), output);
+
+    if (expOutput)
+        for (size_t o = 0; o < layers.back().outSize; ++o)
+            output[o] = std::exp(output[o]);
+}
+
+template<typename eT>
+void CInferenceEngine<eT>::Predict(const arma::Mat<eT>& inputs, arma::Mat<eT>& outputs) const
+{
+    outputs.set_size(OutputSize(), inputs.n_cols);
+    if (layers.empty() || inputs.n_rows != InputSize())
+    {
+        outputs.reset();
+        return;
+    }
+
+#pragma omp parallel for schedule(static) if(inputs.n_cols > 1024 && !omp_in_parallel())
+    for (long long j = 0; j < static_cast<long long>(inputs.n_cols); ++j)
+        Predict(inputs.colptr(j), outputs.colptr(j));
+}
@@ -0,0 +1,92 @@
+/**
+ * @file lagembedding.cpp
+ * @brief Implements the lag-embedding kernel (see lagembedding.h).
+ */
+
+#include "lagembedding.h"
+
+#include <algorithm>
+#include <cstring>
+#include <omp.h>
+
+int MaxLag(const std::vector<std::vector<int>> &lags)
+{
+    int maxLag = 0;
+    for (const auto &lagList : lags)
+        if (!lagList.empty())
+            maxLag = std::max(maxLag, *std::max_element(lagList.begin(), lagList.end()));
+    return maxLag;
+}
+
+// Copies nRows contiguous source windows into the rows of a column-major
+// destination with leading dimension nRows. A single row is itself contiguous
+// and is copied with one memcpy; otherwise samples are processed in tiles so
+// that the destination block of a tile stays in cache while every window is
+// scattered into it.
+static void ScatterRows(const std::vector<const double *> &sources,
+                        arma::uword nSamples,
+                        double *destination)
+{
+    const arma::uword nRows = sources.size();
+    if (nRows == 0 || nSamples == 0)
+        return;
+
+    if (nRows == 1)
+    {
+        std::memcpy(destination, sources[0], nSamples * sizeof(double));
+        return;
+    }
+
+    // ~256 KB of destination per tile
+    const arma::uword tile = std::max<arma::uword>(16, 32768 / nRows);
+    const arma::uword nTiles = (nSamples + tile - 1) / tile;
+    const bool large = nRows * nSamples > (1u << 20);
+
+    #pragma omp parallel for schedule(static) if(large && !omp_in_parallel())
+    for (long long b = 0; b < static_cast<long long>(nTiles); ++b)
+    {
+        const arma::uword j0 = b * tile;
+        const arma::uword j1 = std::min(nSamples, j0 + tile);
+        for (arma::uword r = 0; r < nRows; ++r)
+        {
+            const double *src = sources[r];
+            double *dst = destination + r;
+            for (arma::uword j = j0; j < j1; ++j)
+                dst[j * nRows] = src[j];
+        }
+    }
+}
+
+void BuildLaggedMatrix(const arma::mat &series,
+                       const std::vector<int> &columns,
+                       const std::vector<std::vector<int>> &lags,
+                       int maxLag,
+                       arma::mat &X)
+{
+    const arma::uword n = series.n_rows;
+    const arma::uword nSamples = (n > static_cast<arma::uword>(maxLag)) ? n - maxLag : 0;
+
+    std::vector<const double *> sources;
+    for (unsigned int i = 0; i < columns.size() && i < lags.size(); ++i)
+        for (int lag : lags[i])
+            sources.push_back(series.colptr(columns[i]) + (maxLag - lag));
+
+    X.set_size(sources.size(), nSamples);
+    ScatterRows(sources, nSamples, X.memptr());
+}
+
+void BuildTargetMatrix(const arma::mat &series,
+                       const std::vector<int> &columns,
+                       int maxLag,
+                       arma::mat &Y)
+{
+    const arma::uword n = series.n_rows;
+    const arma::uword nSamples = (n > static_cast<arma::uword>(maxLag)) ? n - maxLag : 0;
+
+    std::vector<const double *> sources;
+    for (int column : columns)
+        sources.push_back(series.colptr(column) + maxLag);
+
+    Y.set_size(sources.size(), nSamples);
+    ScatterRows(sources, nSamples, Y.memptr());
+}
@@ -0,0 +1,61 @@
+/**
+ * @file lagembedding.h
+ * @brief Declares the lag-embedding kernel that builds lagged design matrices
+ *        directly from raw time-major columns.
+ *
+ * @details
+ * For a model with input columns c_i and lag lists L_i, sample j of the design
+ * matrix corresponds to time step t = j + maxLag and holds
+ *
+ *     X(r(i,l), j) = series(t - L_i[l], c_i)
+ *
+ * where rows are ordered column by column and, within a column, in lag order.
+ * Targets are Y(k, j) = series(t, o_k). Samples whose lags would reach before
+ * the first time step are never produced, so no trimming copy is needed.
+ *
+ * The output matrices are preallocated once (Armadillo reuses the storage if
+ * they already have the right size) and filled in place: every (column, lag)
+ * pair reads one contiguous window of its source series and scatters it into
+ * its row in cache-sized tiles of samples.
+ *
+ * @see FFNWrapper_Multi::Shifter()
+ * @see CDataTable
+ */
+
+#pragma once
+
+#include <armadillo>
+#include <vector>
+
+/**
+ * @brief Largest lag over all lag lists (0 if all lists are empty).
+ */
+int MaxLag(const std::vector<std::vector<int>> &lags);
+
+/**
+ * @brief Fill X with the lagged inputs of @p series.
+ *
+ * @param series  Raw data, n_time × n_variables (each column contiguous).
+ * @param columns Variables used as inputs (aligned with @p lags).
+ * @param lags    Lags per input variable, in time steps.
+ * @param maxLag  First usable time step (normally MaxLag(lags)).
+ * @param X       Output, (Σ|lags_i|) × (n_time - maxLag).
+ */
+void BuildLaggedMatrix(const arma::mat &series,
+                       const std::vector<int> &columns,
+                       const std::vector<std::vector<int>> &lags,
+                       int maxLag,
+                       arma::mat &X);
+
+/**
+ * @brief Fill Y with the targets of @p series aligned with BuildLaggedMatrix().
+ *
+ * @param series  Raw data, n_time × n_variables.
+ * @param columns Output variables.
+ * @param maxLag  Same value as passed to BuildLaggedMatrix().
+ * @param Y       Output, |columns| × (n_time - maxLag).
+ */
+void BuildTargetMatrix(const arma::mat &series,
+                       const std::vector<int> &columns,
+                       int maxLag,
+                       arma::mat &Y);
@@ -19,11 +19,14 @@
  *   - All file paths
  *   - ModelCreator parameters
  *
+ * - Optionally run a micro-benchmark (RunBenchmark()) instead of training
+ * - Optionally score many files with a saved model (RunBatchScoring()) instead of training
  * - Build the model structure via BuildModelStructure()
  * - Build input/output file addresses via BuildAddresses()
  * - Execute training mode:
  *   - RunGA()
  *   - RunRandom()
+ *   - RunBayesian()
  *   - RunSingle()
  *
  * ## Workflow Overview
@@ -58,7 +61,10 @@
 
 #include <mlpack.hpp>
 #include <iostream>
+#include <omp.h>
 
+#include "batchscorer.h"
+#include "benchmark.h"
 #include "config.h"
 #include "modelbuilder.h"
 #include "trainer.h"
@@ -76,6 +82,9 @@ int main()
     cfg.log_output_d = false;       ///< Log-transform output?
     cfg.Seed_number  = 42;          ///< Random seed.
     cfg.Realization  = 1;           ///< Number of realizations.
+    cfg.n_threads    = 8;           ///< Threads for parallel GA/RMS evaluation and OpenMP/BLAS.
+    cfg.debug_level  = 0;           ///< >0 writes normalized/shifted diagnostic files.
+    cfg.save_model   = true;        ///< Write the trained model bundle (model.ffnb) to the output path.
 
     if (cfg.ASM)
     {
@@ -106,25 +115,54 @@ int main()
     cfg.kfold          = false;
     cfg.kfold_num      = 10;
     cfg.kfold_splitMode = 2;
+    cfg.kfold_parallel  = true;
 
     // =====================================================================
-    // 4. GENETIC ALGORITHM SETTINGS
+    // 4. TRAINING (OPTIMIZER) SETTINGS
+    // =====================================================================
+
+    cfg.training.optimizer     = "Adam";   ///< "Adam", "SGD" or "RMSProp".
+    cfg.training.batch_size    = 32;
+    cfg.training.epochs        = 10;       ///< Epochs per training; an upper bound for search candidates with early stopping.
+    cfg.training.learning_rate = 0.003;
+    cfg.training.tolerance     = 1e-8;
+    cfg.training.shuffle       = true;
+
+    cfg.training.early_stopping      = false;  ///< Stop on a validation plateau; structure searches use cfg.search_early_stopping.
+    cfg.training.validation_fraction = 0.1;    ///< Tail of the training window used for validation.
+    cfg.training.patience            = 3;      ///< Epochs without improvement before stopping.
+
+    cfg.training.single_precision    = false;  ///< Train/predict in float (mlpack 4); compare with cfg.benchmark = "precision".
+
+    // =====================================================================
+    // 5. GENETIC ALGORITHM SETTINGS
     // =====================================================================
 
     cfg.GA_switch          = false;
     cfg.GA_Nsim            = 100;
     cfg.MSE_Test           = true;
     cfg.optimized_structure = true;
+    cfg.GA_parallel        = true;
+    cfg.GA_persist_cache   = true;
+    cfg.GA_steady_state    = false;    ///< true = asynchronous steady-state GA (GA_Nsim x population offspring).
+    cfg.GA_checkpoint      = true;     ///< Resume an interrupted GA run from Results/GA_checkpoint.bin.
+    cfg.GA_successive_halving = false; ///< Multi-fidelity evaluation: epochs/9, epochs/3, then full training for the best.
+    cfg.search_early_stopping = true;  ///< Early stopping for GA/RMS/Bayesian candidates (cuts time per candidate).
 
     // =====================================================================
-    // 5. RANDOM MODEL STRUCTURE SEARCH
+    // 6. RANDOM MODEL STRUCTURE SEARCH
     // =====================================================================
 
     cfg.randommodelstructure = false;
     cfg.Random_Nsim          = 1000;
+    cfg.Random_parallel      = true;   ///< Train structures concurrently (isolated output slots, single writer).
+    cfg.Random_sampler       = "lhs";  ///< "uniform" or "lhs" (Latin hypercube); duplicates are skipped in both.
+
+    cfg.bayesianoptimization = false;  ///< Gaussian-process search (expected improvement, parallel batches).
+    cfg.Bayesian_Nsim        = 100;    ///< Structures trained by the Bayesian search.
 
     // =====================================================================
-    // 6. FILESYSTEM PATHS
+    // 7. FILESYSTEM PATHS
     // =====================================================================
 
 #ifdef PowerEdge
@@ -142,7 +180,7 @@ int main()
     cfg.datapath_ASM = cfg.path_ASM;
 
     // =====================================================================
-    // 7. MODELCREATOR SETTINGS (for GA/RMS)
+    // 8. MODELCREATOR SETTINGS (for GA/RMS)
     // =====================================================================
 
     cfg.modelCreator.lag_frequency               = 3;
@@ -155,7 +193,28 @@ int main()
     cfg.modelCreator.max_number_of_nodes_in_layers = 40;
 
     // =====================================================================
-    // 8. BUILD MODEL STRUCTURE AND PATHS
+    // 9. MICRO-BENCHMARKS (instead of training)
+    // =====================================================================
+
+    cfg.benchmark = "";             ///< "" = train normally, "lag" = lag-matrix builder, "batch" = training throughput, "latency" = single-sample inference, "precision" = double vs. float training, "cache" = cached vs. file inputs.
+
+    // OpenMP/BLAS threads for the whole run; parallel loops below pick their own counts
+    if (cfg.n_threads > 0)
+        omp_set_num_threads(cfg.n_threads);
+
+    // =====================================================================
+    // 10. BATCH SCORING WITH A SAVED MODEL (instead of training)
+    // =====================================================================
+
+    cfg.score_model      = cfg.path_ASM + "Results/model.ffnb";   ///< Bundle written with cfg.save_model.
+    cfg.score_files      = {};                                    ///< e.g. { cfg.datapath_ASM + "archive_2019.txt", ... }
+    cfg.score_outputpath = cfg.path_ASM + "Results/Scored/";
+
+    if (!cfg.score_files.empty())
+        return RunBatchScoring(cfg) ? 0 : 1;
+
+    // =====================================================================
+    // 11. BUILD MODEL STRUCTURE AND PATHS
     // =====================================================================
 
     CModelStructure_Multi ms;
@@ -163,8 +222,11 @@ int main()
     BuildModelStructure(ms, cfg);   ///< Build layers, nodes, lags, IO columns.
     BuildAddresses(ms, cfg);        ///< Build input/output file paths.
 
+    if (!cfg.benchmark.empty())
+        return RunBenchmark(ms, cfg) ? 0 : 1;
+
     // =====================================================================
-    // 9. SELECT AND EXECUTE TRAINING MODE
+    // 12. SELECT AND EXECUTE TRAINING MODE
     // =====================================================================
 
     if (cfg.GA_switch)
@@ -175,6 +237,10 @@ int main()
     {
         RunRandom(ms, cfg);
     }
+    else if (cfg.bayesianoptimization)
+    {
+        RunBayesian(ms, cfg);
+    }
     else
     {
         RunSingle(ms, cfg);
@@ -0,0 +1,70 @@
+/**
+ * @file metrics.cpp
+ * @brief Implements ComputeMetrics() (see metrics.h).
+ */
+
+#include "metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+std::vector<CMetrics> ComputeMetrics(const arma::mat& prediction, const arma::mat& target)
+{
+    if (arma::size(prediction) != arma::size(target))
+        throw std::invalid_argument("ComputeMetrics: prediction and target sizes differ.");
+
+    const arma::uword nOutputs = target.n_rows;
+    const arma::uword n = target.n_cols;
+    std::vector<CMetrics> metrics(nOutputs);
+    if (n == 0)
+        return metrics;
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    for (arma::uword r = 0; r < nOutputs; ++r)
+    {
+        // Sums around the first observation keep the variance terms well conditioned
+        const double shift = target(r, 0);
+        double sumP = 0, sumO = 0, sumPP = 0, sumOO = 0, sumPO = 0, sumSE = 0, sumAE = 0;
+
+        for (arma::uword j = 0; j < n; ++j)
+        {
+            const double p = prediction(r, j) - shift;
+            const double o = target(r, j) - shift;
+            const double e = p - o;
+            sumP  += p;
+            sumO  += o;
+            sumPP += p * p;
+            sumOO += o * o;
+            sumPO += p * o;
+            sumSE += e * e;
+            sumAE += std::abs(e);
+        }
+
+        const double meanP = sumP / n;
+        const double meanO = sumO / n;
+        const double varP  = std::max(0.0, sumPP / n - meanP * meanP);
+        const double varO  = std::max(0.0, sumOO / n - meanO * meanO);
+        const double cov   = sumPO / n - meanP * meanO;
+
+        CMetrics& m = metrics[r];
+        m.MSE  = sumSE / n;
+        m.MAE  = sumAE / n;
+        m.nMSE = m.MSE / varO;
+        m.NSE  = 1.0 - m.nMSE;
+
+        const double correlation = (varP > 0 && varO > 0) ? cov / std::sqrt(varP * varO) : nan;
+        m.R2 = correlation * correlation;
+
+        // KGE uses the unshifted means
+        const double alpha = std::sqrt(varP / varO);
+        const double beta  = (meanP + shift) / (meanO + shift);
+        m.KGE = 1.0 - std::sqrt((correlation - 1.0) * (correlation - 1.0) +
+                                (alpha - 1.0) * (alpha - 1.0) +
+                                (beta - 1.0) * (beta - 1.0));
+    }
+
+    return metrics;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file metrics.h
+ * @brief Declares CMetrics and ComputeMetrics(), goodness-of-fit measures
+ *        computed directly on Armadillo matrices.
+ *
+ * @details
+ * Predictions and targets are laid out as everywhere else in the wrapper:
+ * one row per output variable, one column per sample. Every row is reduced
+ * in a single pass over its samples; no CTimeSeriesSet is built.
+ *
+ * Definitions (per output row, n samples, p = prediction, o = observation):
+ *
+ * | Measure | Definition                                               |
+ * |---------|----------------------------------------------------------|
+ * | MSE     | Σ(p − o)² / n                                            |
+ * | nMSE    | MSE / var(o), population variance                        |
+ * | R2      | squared Pearson correlation of p and o                   |
+ * | NSE     | 1 − Σ(p − o)² / Σ(o − ō)²  (= 1 − nMSE)                  |
+ * | KGE     | 1 − √((r − 1)² + (σp/σo − 1)² + (p̄/ō − 1)²)             |
+ * | MAE     | Σ|p − o| / n                                             |
+ *
+ * nMSE and R2 follow the conventions of diff2()/variance()/R2() of the
+ * CTimeSeries utilities previously used by PerformanceMetrics(), so existing
+ * GA fitness values stay comparable.
+ *
+ * @see FFNWrapper_Multi::PerformanceMetrics()
+ */
+
+#pragma once
+
+#include <armadillo>
+#include <vector>
+
+/**
+ * @struct CMetrics
+ * @brief Goodness-of-fit of one output variable.
+ */
+struct CMetrics
+{
+    double MSE  = 0.0;
+    double nMSE = 0.0;
+    double R2   = 0.0;
+    double NSE  = 0.0;
+    double KGE  = 0.0;
+    double MAE  = 0.0;
+};
+
+/**
+ * @brief Metrics of every output row of @p prediction against @p target.
+ *
+ * @param prediction Predictions, n_outputs × n_samples.
+ * @param target     Observations, same size as @p prediction.
+ * @return One CMetrics per row.
+ *
+ * @throws std::invalid_argument if the sizes differ.
+ */
+std::vector<CMetrics> ComputeMetrics(const arma::mat& prediction, const arma::mat& target);
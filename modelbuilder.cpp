@@ -24,6 +24,8 @@ void BuildModelStructure(CModelStructure_Multi& ms, const Config& cfg)
     ms.log_output   = cfg.log_output_d;
     ms.realization  = cfg.Realization;
     ms.seed_number  = cfg.Seed_number;
+    ms.debug_level  = cfg.debug_level;
+    ms.training     = cfg.training;
 
     const std::string& data_name    = cfg.data_name;
     double total_data_cols          = cfg.total_data_cols;
@@ -17,6 +17,7 @@
 #include "modelcreator.h"
 #include <QFile>
 #include <QTextStream>
+#include <algorithm>
 #include <gsl/gsl_rng.h>
 #include <BTCSet.h>
 
@@ -195,6 +196,62 @@ bool ModelCreator::CreateRandomModelStructure(CModelStructure_Multi *modelstruct
 }
 
 
+// ======================================================================
+//  Latin-hypercube sampling (multi-output)
+// ======================================================================
+
+/**
+ * @brief Stratified design over the genes drawn by CreateRandomModelStructure().
+ *
+ * @details
+ * Gene g takes integer values in [1, upper_g]. For every gene the unit
+ * interval is cut into n_samples strata, the strata are shuffled
+ * independently per gene, and sample k takes a uniform point inside its
+ * stratum of every gene. Unlike independent draws, no part of any gene's
+ * range is left out, and the same budget spreads over more distinct
+ * column masks, lag masks and layer layouts.
+ */
+vector<vector<long int>> ModelCreator::LatinHypercube(unsigned int n_samples)
+{
+    vector<unsigned long> upper(ParametersSize());
+    upper[0] = static_cast<unsigned long>(pow(2, total_number_of_columns)) - 1;
+    upper[1] = max_lag_multiplier - 1;
+    for (int i = 0; i < total_number_of_columns; i++)
+        upper[i + 2] = static_cast<unsigned long>(pow(lag_frequency, maximum_superficial_lag)) - 1;
+    upper[total_number_of_columns + 2] =
+        static_cast<unsigned long>(pow(max_number_of_layers, max_number_of_layers + 1)) - 2;
+
+    vector<vector<long int>> design(n_samples, vector<long int>(upper.size()));
+    vector<unsigned int> strata(n_samples);
+
+    for (unsigned int g = 0; g < upper.size(); g++)
+    {
+        // Fisher–Yates shuffle of the strata of this gene
+        for (unsigned int k = 0; k < n_samples; k++)
+            strata[k] = k;
+        for (unsigned int k = n_samples; k > 1; k--)
+            std::swap(strata[k - 1], strata[gsl_rng_uniform_int(r, k)]);
+
+        const unsigned long count = std::max<unsigned long>(upper[g], 1);
+        for (unsigned int k = 0; k < n_samples; k++)
+        {
+            const double u = (strata[k] + gsl_rng_uniform(r)) / n_samples;
+            const unsigned long offset = std::min(static_cast<unsigned long>(u * count), count - 1);
+            design[k][g] = static_cast<long int>(offset + 1);
+        }
+    }
+
+    return design;
+}
+
+bool ModelCreator::CreateModelFromParameters(const vector<long int> &params, CModelStructure_Multi *modelstructure)
+{
+    parameters = params;
+    clear(modelstructure);
+    return CreateModel(modelstructure);
+}
+
+
 // ======================================================================
 //  Decode chromosome → CModelStructure (single-output)
 // ======================================================================
@@ -106,6 +106,15 @@ public:
         return true;
     }
 
+    /**
+     * @brief Restart the random stream of this creator from @p seed.
+     *
+     * @note Copies of a ModelCreator allocate their own generator with the GSL
+     *       default seed; parallel workers seed theirs differently so they draw
+     *       independent structures.
+     */
+    void SeedRandom(unsigned long seed) { gsl_rng_set(r, seed); }
+
     /**
      * @brief Get the number of structural parameters encoded.
      *
@@ -162,6 +171,27 @@ public:
      */
     bool CreateRandomModelStructure(CModelStructure_Multi *modelstructure);
 
+    /**
+     * @brief Latin-hypercube design over the encoded parameter space.
+     *
+     * @param n_samples Number of parameter vectors.
+     * @return n_samples parameter vectors with the same gene ranges as
+     *         CreateRandomModelStructure(). Along every gene the range is split
+     *         into n_samples equal strata and each stratum is hit exactly once.
+     *
+     * @note Uses (and advances) the internal RNG.
+     */
+    vector<vector<long int>> LatinHypercube(unsigned int n_samples);
+
+    /**
+     * @brief Decode a given parameter vector (e.g. a row of LatinHypercube()).
+     *
+     * @param params         Encoded parameters.
+     * @param modelstructure Output pointer.
+     * @return true if successful.
+     */
+    bool CreateModelFromParameters(const vector<long int> &params, CModelStructure_Multi *modelstructure);
+
     /**
      * @brief Determine maximum possible parameter value for parameter index i.
      *
@@ -0,0 +1,104 @@
+/**
+ * @file streamingpredictor.cpp
+ * @brief Implements CStreamingPredictor (see streamingpredictor.h).
+ */
+
+#include "streamingpredictor.h"
+#include "ffnwrapper_multi.h"
+#include "lagembedding.h"
+
+#include <QDebug>
+#include <cmath>
+
+bool CStreamingPredictor::Load(const FFNWrapper_Multi& model)
+{
+    const CModelStructure_Multi& ms = model.ModelStructure;
+    if (ms.lags.size() != ms.inputcolumns.size())
+    {
+        qWarning() << "[Streaming] ❌ Lags and input columns are not aligned.";
+        return false;
+    }
+
+    if (!engine.Load(model))
+        return false;
+
+    inputcolumns = ms.inputcolumns;
+    lags = ms.lags;
+    maxLag = ::MaxLag(lags);
+    window = static_cast<size_t>(maxLag) + 1;
+
+    size_t n_features = 0;
+    for (const std::vector<int>& l : lags)
+        n_features += l.size();
+
+    if (n_features != engine.InputSize())
+    {
+        qWarning() << "[Streaming] ❌ The lags define" << n_features
+                   << "features, the network expects" << engine.InputSize();
+        engine = CInferenceEngine<double>();
+        return false;
+    }
+
+    features.assign(n_features, 0.0);
+    ring.assign(inputcolumns.size() * window, 0.0);
+    Reset();
+    return true;
+}
+
+bool CStreamingPredictor::LoadBundle(const std::string& filename)
+{
+    FFNWrapper_Multi model;
+    if (!model.LoadModel(filename))
+        return false;
+    return Load(model);
+}
+
+void CStreamingPredictor::Reset()
+{
+    head = window - 1;      // the first Push() writes slot 0
+    observations = 0;
+}
+
+bool CStreamingPredictor::Push(const std::vector<double>& row, std::vector<double>& prediction)
+{
+    if (!engine.IsLoaded())
+        return false;
+
+    // Reject a short row before touching the buffer, so the lag window stays aligned
+    for (int column : inputcolumns)
+        if (static_cast<size_t>(column) >= row.size())
+        {
+            qWarning() << "[Streaming] ❌ Row has" << row.size() << "values, input column"
+                       << column << "is missing.";
+            return false;
+        }
+
+    // Overwrite the oldest slot of every input with the new observation;
+    // missing readings become 0, as Shifter() and the batch scorer clean them
+    head = (head + 1 == window) ? 0 : head + 1;
+    for (size_t i = 0; i < inputcolumns.size(); ++i)
+    {
+        const double value = row[static_cast<size_t>(inputcolumns[i])];
+        ring[i * window + head] = std::isfinite(value) ? value : 0.0;
+    }
+    ++observations;
+
+    if (observations <= static_cast<size_t>(maxLag))
+        return false;
+
+    // Gather in the row order of BuildLaggedMatrix(): input by input, lag by lag
+    size_t r = 0;
+    for (size_t i = 0; i < lags.size(); ++i)
+    {
+        const double* slots = ring.data() + i * window;
+        for (int lag : lags[i])
+        {
+            const size_t slot = (head + window - static_cast<size_t>(lag)) % window;
+            features[r++] = slots[slot];
+        }
+    }
+
+    prediction.resize(engine.OutputSize());
+    engine.Predict(features.data(), prediction.data());
+    return true;
+}
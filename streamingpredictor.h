@@ -0,0 +1,85 @@
+/**
+ * @file streamingpredictor.h
+ * @brief Declares CStreamingPredictor, which predicts from one new observation
+ *        at a time instead of a whole data file.
+ *
+ * @details
+ * Shifter() builds the lagged design matrix of complete files. On-line use
+ * (one new row of plant measurements per time step) only ever needs the last
+ * maxLag + 1 values of every input variable, so the predictor keeps them in a
+ * ring buffer per input column:
+ *
+ *     ring[i][(head - L) mod (maxLag + 1)] = series(t - L, c_i)
+ *
+ * Push() overwrites the oldest slot with the new row, gathers the lagged
+ * feature vector in the row order of BuildLaggedMatrix() and runs it through a
+ * CInferenceEngine. Each step therefore costs O(number of features) plus one
+ * forward pass; nothing is shifted or reallocated.
+ *
+ * The first maxLag rows only fill the buffers; predictions start with row
+ * maxLag + 1, which corresponds to the first column of the design matrix.
+ *
+ * Usage:
+ * @code
+ * CStreamingPredictor predictor;
+ * predictor.LoadBundle(outputpath + "model.ffnb");
+ * std::vector<double> prediction;
+ * while (ReadRow(row))                    // row indexed like the data-file columns
+ *     if (predictor.Push(row, prediction))
+ *         Report(prediction);
+ * @endcode
+ *
+ * @see CInferenceEngine
+ * @see BuildLaggedMatrix()
+ */
+
+#pragma once
+
+#include "inferenceengine.h"
+
+#include <string>
+#include <vector>
+
+class CStreamingPredictor
+{
+public:
+
+    /// Take the lags, input columns, weights and scaling of a trained model.
+    bool Load(const FFNWrapper_Multi& model);
+
+    /// Read a bundle written by FFNWrapper_Multi::SaveModel().
+    bool LoadBundle(const std::string& filename);
+
+    /**
+     * @brief Add the observation of the next time step.
+     *
+     * @param row        All variables of the time step, indexed like the data-file
+     *                   columns (ModelStructure.inputcolumns select from it).
+     * @param prediction Model outputs for this time step, if the buffers are full.
+     * @return true if @p prediction was written. A row too short for the
+     *         input columns is rejected and leaves the buffers unchanged.
+     *         NaN/Inf values are stored as 0, as in training.
+     */
+    bool Push(const std::vector<double>& row, std::vector<double>& prediction);
+
+    /// Forget all buffered observations; the next maxLag rows warm up again.
+    void Reset();
+
+    bool Ready() const { return engine.IsLoaded() && observations > static_cast<size_t>(maxLag); }
+    int MaxLag() const { return maxLag; }
+    size_t FeatureCount() const { return features.size(); }
+
+private:
+    CInferenceEngine<double> engine;
+
+    std::vector<int> inputcolumns;
+    std::vector<std::vector<int>> lags;
+    int maxLag = 0;
+
+    std::vector<double> ring;       // input i occupies [i * window, (i + 1) * window)
+    size_t window = 1;              // maxLag + 1
+    size_t head = 0;                // slot of the newest observation
+    size_t observations = 0;        // rows pushed since Load()/Reset()
+
+    std::vector<double> features;   // lagged feature vector, reused every step
+};
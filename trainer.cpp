@@ -20,6 +20,11 @@
  *    - Runs a single, deterministic model structure
  *    - Performs training, testing, metrics, and plotting
  *
+ * 4. **RunBayesian()**
+ *    - Fits a Gaussian process to the structures trained so far
+ *    - Trains batches of the candidates with the highest expected improvement
+ *    - Saves structure strings to BO_Output.txt and the best to BO_results.txt
+ *
  * These functions keep the main pipeline simple and modular, while storing all
  * architecture logic in BuildModelStructure() and all path logic in BuildAddresses().
  *
@@ -30,11 +35,21 @@
 
 #include "trainer.h"
 #include "ga.h"
+#include "bayesopt.h"
+#include "boundedqueue.h"
+#include "datacache.h"
+#include "fitnesscache.h"
 
 #include <QFile>
 #include <QTextStream>
 #include <QDebug>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <fstream>
+#include <omp.h>
+#include <set>
+#include <thread>
 
 /**
  * @brief Execute Genetic Algorithm (GA) optimization for model structure.
@@ -46,14 +61,21 @@
  *    - Number of generations: @c cfg.GA_Nsim
  *    - Objective: MSE-Test (if cfg.MSE_Test = true)
  *    - ModelCreator instance from @c cfg.modelCreator
+ *    - Parallel evaluation on @c cfg.n_threads threads (if cfg.GA_parallel = true)
+ *    - Fitness cache persisted to "GA_fitness_cache.txt" (if cfg.GA_persist_cache = true)
+ *    - Steady-state evolution instead of generations (if cfg.GA_steady_state = true)
+ *    - Checkpoint "GA_checkpoint.bin" after every generation; an interrupted run resumes from it
+ *      (if cfg.GA_checkpoint = true)
  *
  * 2. Run GA:
+ *    - Train/test files are parsed once into a shared CDataCache
  *    - GA internally tests network structures using FFNWrapper_Multi
  *    - The best model structure is selected and returned
  *
  * 3. Save Outputs:
  *    - Train and Test predictions
  *    - GA results file: "GA_results.txt"
+ *    - Model bundle of the best structure: "model.ffnb" (if cfg.save_model = true)
  *
  * @param ms   Model structure used by the GA and updated inside GA.Model.
  * @param cfg  Configuration (non-const because GA modifies ModelCreator state).
@@ -63,12 +85,27 @@
  */
 void RunGA(CModelStructure_Multi& ms, Config& cfg)
 {
+    // Parse the train/test files once; every candidate gathers its lags from here
+    CDataCache DataCache;
+    if (DataCache.Load(ms))
+        ms.DataCache = &DataCache;
+    ms.training.early_stopping = cfg.search_early_stopping;
+
     GeneticAlgorithm<ModelCreator> GA;
 
     // Configure GA settings
     GA.Settings.generations       = cfg.GA_Nsim;
     GA.Settings.MSE_optimization  = cfg.MSE_Test;
     GA.Settings.outputpath        = ms.outputpath;
+    GA.Settings.parallel_evaluation = cfg.GA_parallel;
+    GA.Settings.numthreads        = cfg.n_threads;
+    GA.Settings.random_seed       = static_cast<unsigned long>(cfg.Seed_number);
+    GA.Settings.steady_state      = cfg.GA_steady_state;
+    GA.Settings.successive_halving = cfg.GA_successive_halving;
+    if (cfg.GA_persist_cache)
+        GA.Settings.fitness_cache_file = ms.outputpath + "GA_fitness_cache.txt";
+    if (cfg.GA_checkpoint)
+        GA.Settings.checkpoint_file = ms.outputpath + "GA_checkpoint.bin";
 
     // Assign model creator
     GA.model = cfg.modelCreator;
@@ -84,7 +121,11 @@ void RunGA(CModelStructure_Multi& ms, Config& cfg)
     OptimizedModel.FFN.DataSave(datacategory::Train);
     OptimizedModel.FFN.DataSave(datacategory::Test);
 
+    if (cfg.save_model)
+        OptimizedModel.FFN.SaveModel(ms.outputpath + "model.ffnb");
+
     // Write GA output file
+    ms.DataCache = nullptr;
     QFile file(QString::fromStdString(ms.outputpath + "GA_results.txt"));
     if (file.open(QIODevice::WriteOnly | QIODevice::Text))
     {
@@ -106,6 +147,19 @@ void RunGA(CModelStructure_Multi& ms, Config& cfg)
  * This function generates a large number of **random neural network architectures**
  * using @c cfg.modelCreator.CreateRandomModelStructure().
  *
+ * The train/test files are parsed once into a shared CDataCache.
+ *
+ * With @c cfg.Random_parallel, @c cfg.n_threads workers train structures side by
+ * side. Every worker owns a copy of the ModelCreator with its own GSL stream
+ * and writes its intermediate files into Results/rms_worker_<n>/. Finished
+ * structures are appended to RMS_Output.txt by a single writer thread, in
+ * completion order.
+ *
+ * Structures are drawn independently (@c cfg.Random_sampler = "uniform") or
+ * from a Latin-hypercube design over the encoded genes ("lhs"), which covers
+ * the column/lag/node ranges evenly. Either way, a drawn structure whose
+ * CFitnessCache::Key() was already trained in this run is skipped.
+ *
  * For each random structure:
  * - Validate lag consistency
  * - Train FFNWrapper_Multi
@@ -137,42 +191,331 @@ void RunRandom(CModelStructure_Multi& ms, Config& cfg)
         return;
     }
 
-    // Iterate through random simulations
-    for (int i = 0; i < cfg.Random_Nsim; i++)
+    // Parse the train/test files once; every trial gathers its lags from here
+    CDataCache DataCache;
+    if (DataCache.Load(ms))
+        ms.DataCache = &DataCache;
+    ms.training.early_stopping = cfg.search_early_stopping;
+
+    // Single writer: workers hand over finished lines, only this thread touches the file
+    CBoundedQueue<std::string> lines(64);
+    std::thread writer([&file, &lines]()
+    {
+        std::string line;
+        while (lines.Pop(line))
+            file << line << "\n" << std::flush;
+    });
+
+    const int workers = cfg.Random_parallel ? std::max(cfg.n_threads, 1) : 1;
+    std::atomic<int> next{0};
+
+    // Shared sampler state: Latin-hypercube design (refilled when used up) and decoded structures seen so far
+    const bool lhs = (cfg.Random_sampler == "lhs");
+    const unsigned int designSize = static_cast<unsigned int>(std::max(cfg.Random_Nsim, 1.0));
+    ModelCreator sampler = cfg.modelCreator;
+    sampler.SeedRandom(static_cast<unsigned long>(cfg.Seed_number));
+    std::vector<std::vector<long int>> design;
+    size_t nextPoint = 0;
+    std::set<std::string> seen;
+    std::atomic<int> duplicates{0};
+
+    // Draw the next structure with lags that was not trained yet (after 1000 duplicates in a row,
+    // the space is considered exhausted and a duplicate is accepted)
+    auto draw = [&](ModelCreator &creator, CModelStructure_Multi &local)
+    {
+        for (int attempt = 0; ; attempt++)
+        {
+            if (lhs)
+            {
+                std::vector<long int> point;
+                #pragma omp critical(rms_sampler)
+                {
+                    if (nextPoint == design.size())
+                    {
+                        design = sampler.LatinHypercube(designSize);
+                        nextPoint = 0;
+                    }
+                    point = design[nextPoint++];
+                }
+                creator.CreateModelFromParameters(point, &local);
+            }
+            else
+                creator.CreateRandomModelStructure(&local);
+
+            if (!local.ValidLags())
+                continue;
+
+            bool fresh;
+            #pragma omp critical(rms_sampler)
+            fresh = seen.insert(CFitnessCache::Key(local)).second;
+
+            if (fresh || attempt >= 1000)
+                return;
+            duplicates++;
+        }
+    };
+
+    #pragma omp parallel num_threads(workers)
+    {
+        const int worker = omp_get_thread_num();
+
+        // Own creator and GSL stream per worker, so workers draw different structures
+        ModelCreator creator = cfg.modelCreator;
+        creator.SeedRandom(static_cast<unsigned long>(cfg.Seed_number) + 1000003UL * (worker + 1));
+
+        // Own output slot per worker when trials run side by side
+        CModelStructure_Multi local = ms;
+        if (omp_get_num_threads() > 1)
+            local.IsolateOutputPath("rms_worker_" + std::to_string(worker));
+
+        while (next++ < cfg.Random_Nsim)
+        {
+            // Generate an architecture with lags that was not trained yet
+            draw(creator, local);
+
+            // Prepare FFN wrapper
+            FFNWrapper_Multi F;
+            F.silent = false;
+            F.ModelStructure = local;
+            F.Initiate();
+
+            // Perform training
+            if (!cfg.kfold)
+                F.Train();
+            else
+                F.Train_kfold(cfg.kfold_num, cfg.kfold_splitMode, cfg.kfold_parallel);
+
+            // Evaluate performance
+            F.Test();
+            F.PerformanceMetrics();
+
+            // Save data
+            F.DataSave(datacategory::Train);
+            F.DataSave(datacategory::Test);
+
+            // Write structure summary
+            lines.Push(F.ModelStructure.ParametersToString().toStdString());
+        }
+    }
+
+    lines.Close();
+    writer.join();
+    ms.DataCache = nullptr;
+
+    qInfo() << "[RMS]" << seen.size() << "distinct structures trained," << duplicates.load() << "duplicate draws skipped";
+}
+
+/**
+ * @brief Bayesian optimization of the model structure.
+ *
+ * @details
+ * A Gaussian process over StructureFeatures() (selected columns, lag counts,
+ * lag multiplier, layer widths) predicts the log test nMSE of untrained
+ * structures. Steps:
+ *
+ * 1. Train an initial Latin-hypercube batch of distinct structures.
+ * 2. Repeat until @c cfg.Bayesian_Nsim structures are trained:
+ *    - fit the GP to all trained structures;
+ *    - decode a pool of Latin-hypercube candidates not trained yet;
+ *    - pick a batch of @c cfg.n_threads candidates by expected improvement,
+ *      adding each pick to the GP with the best value seen so far
+ *      ("constant liar") so the batch spreads out instead of repeating one
+ *      region;
+ *    - train the batch in parallel, each worker in its own output slot.
+ * 3. Retrain the best structure, save its predictions (and model bundle).
+ *
+ * The fitness is the GA's: the sum of the test nMSE over all outputs.
+ * Every trained structure is appended to "BO_Output.txt"; the best one is
+ * written to "BO_results.txt".
+ *
+ * @param ms   Model structure supplying paths, outputs and training settings.
+ * @param cfg  Configuration (ModelCreator limits, budget, threads, seed).
+ */
+void RunBayesian(CModelStructure_Multi& ms, Config& cfg)
+{
+    std::ofstream file(cfg.datapath_ASM + "Results/BO_Output.txt");
+    if (!file.is_open())
     {
-        // Generate random architecture
-        cfg.modelCreator.CreateRandomModelStructure(&ms);
+        qWarning() << "Could not open BO_Output.txt for writing.";
+        return;
+    }
+
+    CDataCache DataCache;
+    if (DataCache.Load(ms))
+        ms.DataCache = &DataCache;
+    ms.training.early_stopping = cfg.search_early_stopping;
+
+    const int budget    = static_cast<int>(cfg.Bayesian_Nsim);
+    const int batchSize = std::max(cfg.n_threads, 1);
+    const int initial   = std::min(budget, std::max(2 * batchSize, 10));
+    const unsigned int poolSize = 1000;
+
+    ModelCreator sampler = cfg.modelCreator;
+    sampler.SeedRandom(static_cast<unsigned long>(cfg.Seed_number));
 
-        // Reject structure if lag structure is invalid
-        if (!ms.ValidLags())
+    std::vector<CModelStructure_Multi> trained;
+    std::vector<double> fitness;
+    arma::mat features(0, 0);
+    std::set<std::string> seen;
+
+    // Distinct, untrained structures with lags from a Latin-hypercube design
+    auto propose = [&](unsigned int n)
+    {
+        std::vector<CModelStructure_Multi> out;
+        std::set<std::string> keys;
+        for (const std::vector<long int>& point : sampler.LatinHypercube(n))
         {
-            i--;
-            continue;
+            CModelStructure_Multi s = ms;
+            sampler.CreateModelFromParameters(point, &s);
+            const std::string key = CFitnessCache::Key(s);
+            if (s.ValidLags() && !seen.count(key) && keys.insert(key).second)
+                out.push_back(s);
         }
+        return out;
+    };
 
-        // Prepare FFN wrapper
-        FFNWrapper_Multi F;
-        F.silent = false;
-        F.ModelStructure = ms;
-        F.Initiate();
+    // Train a batch side by side; fitness = sum of test nMSE
+    auto train = [&](const std::vector<CModelStructure_Multi>& batch)
+    {
+        std::vector<double> result(batch.size(), 1e12);
 
-        // Perform training
-        if (!cfg.kfold)
+        #pragma omp parallel for schedule(dynamic,1) num_threads(batchSize)
+        for (int k = 0; k < static_cast<int>(batch.size()); k++)
+        {
+            FFNWrapper_Multi F;
+            F.ModelStructure = batch[k];
+            if (omp_get_num_threads() > 1)
+                F.ModelStructure.IsolateOutputPath("bo_worker_" + std::to_string(omp_get_thread_num()));
+            F.Initiate();
             F.Train();
-        else
-            F.Train_kfold(cfg.kfold_num, cfg.kfold_splitMode);
+            F.Test();
+            F.PerformanceMetrics();
+
+            double sum = 0;
+            for (double value : F.nMSE_Test)
+                sum += value;
+            result[k] = sum;
+        }
+
+        for (size_t k = 0; k < batch.size(); k++)
+        {
+            seen.insert(CFitnessCache::Key(batch[k]));
+            trained.push_back(batch[k]);
+            fitness.push_back(result[k]);
+            features.insert_cols(features.n_cols, StructureFeatures(batch[k], cfg.modelCreator));
+            file << "fitness=" << result[k] << ","
+                 << batch[k].ParametersToString().toStdString() << std::endl;
+        }
+    };
+
+    // The GP models log fitness; failed or diverged trainings are clipped
+    auto target = [](double f) { return std::log(std::min(std::max(std::isfinite(f) ? f : 1e6, 1e-12), 1e6)); };
+
+    // The GP needs at least one trained structure; LHS points can all fail ValidLags()
+    std::vector<CModelStructure_Multi> design;
+    for (int attempt = 0; attempt < 10 && design.empty(); attempt++)
+        design = propose(initial);
+    if (design.empty())
+    {
+        qWarning() << "[BO] No structure with valid lags in the initial design; check the ModelCreator ranges.";
+        ms.DataCache = nullptr;
+        return;
+    }
+    train(design);
+
+    while (static_cast<int>(trained.size()) < budget)
+    {
+        arma::mat X = features;
+        arma::vec y(fitness.size());
+        for (size_t i = 0; i < fitness.size(); i++)
+            y(i) = target(fitness[i]);
+        const double liar = y.min();
+
+        std::vector<CModelStructure_Multi> pool = propose(poolSize);
+        if (pool.empty())
+            break;
+        arma::mat poolFeatures(X.n_rows, pool.size());
+        for (size_t c = 0; c < pool.size(); c++)
+            poolFeatures.col(c) = StructureFeatures(pool[c], cfg.modelCreator);
+
+        // Constant-liar batch: every pick is assumed to score the current best
+        std::vector<CModelStructure_Multi> batch;
+        std::vector<bool> picked(pool.size(), false);
+        const int q = std::min(batchSize, budget - static_cast<int>(trained.size()));
+        CGaussianProcess gp;
+        for (int b = 0; b < q; b++)
+        {
+            // Without a usable GP, take the next unpicked candidate (the pool is a random design)
+            if (!gp.Fit(X, y))
+            {
+                qWarning() << "[BO] Gaussian process fit failed; picking candidates in pool order.";
+                for (size_t c = 0; c < pool.size() && static_cast<int>(batch.size()) < q; c++)
+                    if (!picked[c])
+                    {
+                        picked[c] = true;
+                        batch.push_back(pool[c]);
+                    }
+                break;
+            }
+
+            int bestCandidate = -1;
+            double bestEI = -1;
+            for (size_t c = 0; c < pool.size(); c++)
+            {
+                if (picked[c])
+                    continue;
+                double mean, sd;
+                gp.Predict(poolFeatures.col(c), mean, sd);
+                const double ei = ExpectedImprovement(mean, sd, liar);
+                if (ei > bestEI)
+                {
+                    bestEI = ei;
+                    bestCandidate = static_cast<int>(c);
+                }
+            }
+            if (bestCandidate < 0)
+                break;
 
-        // Evaluate performance
-        F.Test();
-        F.PerformanceMetrics();
+            picked[bestCandidate] = true;
+            batch.push_back(pool[bestCandidate]);
+            X.insert_cols(X.n_cols, poolFeatures.col(bestCandidate));
+            y.resize(y.n_elem + 1);
+            y(y.n_elem - 1) = liar;
+        }
 
-        // Save data
-        F.DataSave(datacategory::Train);
-        F.DataSave(datacategory::Test);
+        train(batch);
 
-        // Write structure summary
-        file << F.ModelStructure.ParametersToString().toStdString() << "\n";
+        const size_t best = std::min_element(fitness.begin(), fitness.end()) - fitness.begin();
+        qInfo() << "[BO]" << trained.size() << "/" << budget << "trained, best fitness" << fitness[best]
+                << ", GP length scale" << gp.LengthScale();
     }
+
+    if (trained.empty())
+    {
+        ms.DataCache = nullptr;
+        return;
+    }
+
+    // Retrain the best structure in the shared output path and save it
+    const size_t best = std::min_element(fitness.begin(), fitness.end()) - fitness.begin();
+    FFNWrapper_Multi F;
+    F.silent = false;
+    F.ModelStructure = trained[best];
+    F.Initiate();
+    F.Train();
+    F.Test();
+    F.PerformanceMetrics();
+    F.DataSave(datacategory::Train);
+    F.DataSave(datacategory::Test);
+    if (cfg.save_model)
+        F.SaveModel(ms.outputpath + "model.ffnb");
+
+    std::ofstream results(ms.outputpath + "BO_results.txt");
+    results << "Bayesian optimization completed: " << trained.size() << " structures trained.\n"
+            << "Best fitness: " << fitness[best] << "\n"
+            << "Best structure: " << trained[best].ParametersToString().toStdString() << "\n";
+
+    ms.DataCache = nullptr;
 }
 
 /**
@@ -188,7 +531,7 @@ void RunRandom(CModelStructure_Multi& ms, Config& cfg)
  * 2. Train using Train() or Train_kfold()
  * 3. Evaluate using Test()
  * 4. Compute metrics via PerformanceMetrics()
- * 5. Save train/test data
+ * 5. Save train/test data (and the model bundle if @c cfg.save_model)
  * 6. Generate plots via Plotter()
  *
  * This mode is deterministic and ideal for production runs once architecture is fixed.
@@ -207,7 +550,7 @@ void RunSingle(CModelStructure_Multi& ms, Config& cfg)
     if (!cfg.kfold)
         F.Train();
     else
-        F.Train_kfold(cfg.kfold_num, cfg.kfold_splitMode);
+        F.Train_kfold(cfg.kfold_num, cfg.kfold_splitMode, cfg.kfold_parallel);
 
     // Evaluate
     F.Test();
@@ -217,6 +560,10 @@ void RunSingle(CModelStructure_Multi& ms, Config& cfg)
     F.DataSave(datacategory::Train);
     F.DataSave(datacategory::Test);
 
+    // Save the deployable model bundle
+    if (cfg.save_model)
+        F.SaveModel(ms.outputpath + "model.ffnb");
+
     // Create plots
     F.Plotter();
 }
@@ -17,7 +17,12 @@
  *
  * 3. @ref RunSingle()
  *    - Runs a single user-defined model structure (manual or GA-based)
- *    - Used when GA and Random modes are disabled
+ *    - Used when GA, Random and Bayesian modes are disabled
+ *
+ * 4. @ref RunBayesian()
+ *    - Fits a Gaussian process to the fitness of trained structures
+ *    - Trains parallel batches chosen by expected improvement
+ *    - Writes results to BO_Output.txt and BO_results.txt
  *
  * ### Design Goals
  * - Keep main.cpp clean
@@ -88,6 +93,25 @@ void RunGA(CModelStructure_Multi& ms, Config& cfg);
  */
 void RunRandom(CModelStructure_Multi& ms, Config& cfg);
 
+/**
+ * @brief Run Bayesian optimization of the model structure.
+ *
+ * @details
+ * Fits a Gaussian process to the fitness of the structures trained so far
+ * and trains, in parallel batches of @c cfg.n_threads, the candidates with
+ * the highest expected improvement, until @c cfg.Bayesian_Nsim structures
+ * are trained. Aims at GA-quality structures with far fewer trainings.
+ *
+ * Writes "BO_Output.txt" (every trained structure) and "BO_results.txt"
+ * (the best), and saves the predictions of the best structure.
+ *
+ * @param ms   Model structure supplying paths and training settings.
+ * @param cfg  Configuration (ModelCreator limits, budget, threads, seed).
+ *
+ * @note Requires cfg.bayesianoptimization = true in main.cpp.
+ */
+void RunBayesian(CModelStructure_Multi& ms, Config& cfg);
+
 /**
  * @brief Train and evaluate a single model structure.
  *